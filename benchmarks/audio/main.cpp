@@ -0,0 +1,145 @@
+#include <deepgrampp/audio/format.hpp>
+#include <deepgrampp/audio/g711.hpp>
+#include <deepgrampp/audio/opus.hpp>
+#include <deepgrampp/audio/pcm.hpp>
+#include <deepgrampp/audio/resampler.hpp>
+#include <deepgrampp/audio/vad.hpp>
+
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace deepgram;
+
+namespace
+{
+    constexpr int kSeconds = 60;
+    constexpr std::chrono::milliseconds kChunk{20};
+    constexpr double kPi = 3.14159265358979323846;
+
+    // A few partials and some noise, so no stage hits a trivial fast path.
+    std::vector<uint8_t> synthesize(const audio::AudioFormat &format)
+    {
+        const std::size_t frames = static_cast<std::size_t>(format.sampleRate) * kSeconds;
+        std::vector<float> samples(frames * format.channels);
+        uint32_t noise = 1;
+        for (std::size_t i = 0; i < frames; ++i)
+        {
+            const double t = static_cast<double>(i) / format.sampleRate;
+            for (int c = 0; c < format.channels; ++c)
+            {
+                noise = noise * 1664525u + 1013904223u;
+                samples[i * format.channels + c] = static_cast<float>(0.3 * std::sin(2 * kPi * 220 * t) + 0.2 * std::sin(2 * kPi * (3100 + 400 * c) * t) +
+                                                                      0.01 * (static_cast<int32_t>(noise) / 2147483648.0));
+            }
+        }
+
+        std::vector<uint8_t> bytes(samples.size() * format.bytesPerSample());
+        switch (format.sampleFormat)
+        {
+        case audio::SampleFormat::Int16:
+            audio::floatToInt16(samples.data(), reinterpret_cast<int16_t *>(bytes.data()), samples.size());
+            break;
+        case audio::SampleFormat::Int32:
+            audio::floatToInt32(samples.data(), reinterpret_cast<int32_t *>(bytes.data()), samples.size());
+            break;
+        default:
+            std::memcpy(bytes.data(), samples.data(), bytes.size());
+            break;
+        }
+        return bytes;
+    }
+
+    void run(const std::string &name, const audio::AudioFormat &input, const audio::AudioFormat &wire,
+             const std::vector<std::shared_ptr<audio::IAudioStage>> &stages)
+    {
+        const std::vector<uint8_t> audio = synthesize(input);
+        const std::size_t chunk = input.bytesPerSecond() * kChunk.count() / 1000;
+
+        audio::AudioFormat format = input;
+        for (const auto &stage : stages)
+        {
+            format = stage->configure(format, wire);
+        }
+
+        std::vector<uint8_t> buffers[2];
+        std::size_t sent = 0;
+        const auto start = std::chrono::steady_clock::now();
+        for (std::size_t offset = 0; offset < audio.size(); offset += chunk)
+        {
+            const uint8_t *data = audio.data() + offset;
+            std::size_t size = std::min(chunk, audio.size() - offset);
+            for (std::size_t k = 0; k < stages.size(); ++k)
+            {
+                buffers[k % 2].clear();
+                stages[k]->process(data, size, buffers[k % 2]);
+                data = buffers[k % 2].data();
+                size = buffers[k % 2].size();
+            }
+            sent += size;
+        }
+        const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        std::printf("%-44s %8.3f ms/min  %6.3f%% of a core  %8.0fx real time  %5.2f MB -> %5.2f MB\n",
+                    name.c_str(), seconds * 1000.0 * 60 / kSeconds, 100.0 * seconds / kSeconds, kSeconds / seconds,
+                    audio.size() / 1e6, sent / 1e6);
+    }
+
+    audio::AudioFormat pcm(audio::SampleFormat sampleFormat, int sampleRate, int channels)
+    {
+        audio::AudioFormat format;
+        format.sampleFormat = sampleFormat;
+        format.sampleRate = sampleRate;
+        format.channels = channels;
+        return format;
+    }
+}
+
+int main()
+{
+    using audio::SampleFormat;
+    std::printf("PCM kernels: %s; %d s of audio per case, %lld ms chunks, one stream\n\n",
+                audio::simdBackend(), kSeconds, static_cast<long long>(kChunk.count()));
+
+    const audio::AudioFormat wire = audio::wireFormat("linear16", 16000, 1);
+    run("PcmConverter float32 stereo -> int16 mono", pcm(SampleFormat::Float32, 16000, 2), wire,
+        {std::make_shared<audio::PcmConverter>()});
+    run("PcmConverter int32 mono -> int16 mono", pcm(SampleFormat::Int32, 16000, 1), wire,
+        {std::make_shared<audio::PcmConverter>()});
+
+    for (const int rate : {48000, 44100, 8000})
+    {
+        run("Resampler int16 " + std::to_string(rate) + " -> 16000", pcm(SampleFormat::Int16, rate, 1), wire,
+            {std::make_shared<audio::Resampler>()});
+    }
+    run("float32 stereo 48000 -> int16 mono 16000", pcm(SampleFormat::Float32, 48000, 2), wire,
+        {std::make_shared<audio::PcmConverter>(), std::make_shared<audio::Resampler>()});
+
+    run("VoiceActivityGate int16 16000", pcm(SampleFormat::Int16, 16000, 1), wire,
+        {std::make_shared<audio::VoiceActivityGate>()});
+
+    const audio::AudioFormat mulaw = audio::wireFormat("mulaw", 8000, 1);
+    run("G711Encoder int16 -> mulaw 8000", pcm(SampleFormat::Int16, 8000, 1), mulaw,
+        {std::make_shared<audio::G711Encoder>()});
+    run("float32 stereo 48000 -> mulaw 8000", pcm(SampleFormat::Float32, 48000, 2), mulaw,
+        {std::make_shared<audio::PcmConverter>(), std::make_shared<audio::Resampler>(), std::make_shared<audio::G711Encoder>()});
+
+#if defined(DEEPGRAMPP_WITH_OPUS)
+    // The encoder's wire is the PCM it takes; compare the MB columns.
+    run("OpusEncoderStage int16 16000, Ogg 24 kbps", pcm(SampleFormat::Int16, 16000, 1), wire,
+        {std::make_shared<audio::OpusEncoderStage>()});
+    audio::OpusEncoderOptions raw;
+    raw.bitrate = 16000;
+    raw.container = audio::OpusContainer::Raw;
+    run("OpusEncoderStage int16 16000, raw 16 kbps", pcm(SampleFormat::Int16, 16000, 1), wire,
+        {std::make_shared<audio::OpusEncoderStage>(raw)});
+    run("float32 stereo 48000 -> Ogg Opus 16000", pcm(SampleFormat::Float32, 48000, 2), wire,
+        {std::make_shared<audio::PcmConverter>(), std::make_shared<audio::Resampler>(), std::make_shared<audio::OpusEncoderStage>()});
+#endif
+    return 0;
+}
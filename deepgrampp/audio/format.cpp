@@ -0,0 +1,101 @@
+#include <deepgrampp/audio/format.hpp>
+
+namespace deepgram
+{
+    namespace audio
+    {
+        std::size_t AudioFormat::bytesPerSample() const
+        {
+            switch (sampleFormat)
+            {
+            case SampleFormat::Mulaw:
+            case SampleFormat::Alaw:
+                return 1;
+            case SampleFormat::Int16:
+                return 2;
+            case SampleFormat::Int32:
+            case SampleFormat::Float32:
+                return 4;
+            default:
+                return 0;
+            }
+        }
+
+        std::size_t AudioFormat::bytesPerFrame() const
+        {
+            return channels > 0 ? bytesPerSample() * static_cast<std::size_t>(channels) : 0;
+        }
+
+        std::size_t AudioFormat::bytesPerSecond() const
+        {
+            return sampleRate > 0 ? bytesPerFrame() * static_cast<std::size_t>(sampleRate) : 0;
+        }
+
+        bool AudioFormat::linear() const
+        {
+            return sampleFormat == SampleFormat::Int16 || sampleFormat == SampleFormat::Int32 ||
+                   sampleFormat == SampleFormat::Float32;
+        }
+
+        bool AudioFormat::operator==(const AudioFormat &other) const
+        {
+            return sampleFormat == other.sampleFormat && sampleRate == other.sampleRate &&
+                   channels == other.channels && planar == other.planar;
+        }
+
+        AudioFormat wireFormat(const std::string &encoding, int sampleRate, int channels)
+        {
+            AudioFormat format;
+            format.sampleRate = sampleRate;
+            format.channels = channels;
+            if (encoding == "linear16")
+            {
+                format.sampleFormat = SampleFormat::Int16;
+            }
+            else if (encoding == "linear32")
+            {
+                format.sampleFormat = SampleFormat::Int32;
+            }
+            else if (encoding == "mulaw")
+            {
+                format.sampleFormat = SampleFormat::Mulaw;
+            }
+            else if (encoding == "alaw")
+            {
+                format.sampleFormat = SampleFormat::Alaw;
+            }
+            else
+            {
+                format.sampleFormat = SampleFormat::Encoded;
+            }
+            return format;
+        }
+
+        std::string toString(const AudioFormat &format)
+        {
+            const char *sampleFormat = "encoded";
+            switch (format.sampleFormat)
+            {
+            case SampleFormat::Int16:
+                sampleFormat = "int16";
+                break;
+            case SampleFormat::Int32:
+                sampleFormat = "int32";
+                break;
+            case SampleFormat::Float32:
+                sampleFormat = "float32";
+                break;
+            case SampleFormat::Mulaw:
+                sampleFormat = "mulaw";
+                break;
+            case SampleFormat::Alaw:
+                sampleFormat = "alaw";
+                break;
+            default:
+                break;
+            }
+            return std::string(sampleFormat) + " " + std::to_string(format.sampleRate) + " Hz " +
+                   std::to_string(format.channels) + (format.planar ? " ch planar" : " ch");
+        }
+    }
+}
@@ -0,0 +1,309 @@
+#include <deepgrampp/audio/g711.hpp>
+
+#include <spdlog/spdlog.h>
+
+#include <array>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#define DEEPGRAMPP_G711_SSE2 1
+#include <emmintrin.h>
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#define DEEPGRAMPP_G711_NEON 1
+#include <arm_neon.h>
+#endif
+
+namespace deepgram
+{
+    namespace audio
+    {
+        namespace
+        {
+            constexpr std::int32_t kMulawBias = 0x84;
+            constexpr std::int32_t kMulawClip = 32635;
+
+            std::uint8_t mulawEncodeSample(std::int16_t sample)
+            {
+                std::int32_t x = sample;
+                const std::int32_t sign = x < 0 ? 0x80 : 0;
+                x = x < 0 ? -x : x;
+                x = (x > kMulawClip ? kMulawClip : x) + kMulawBias;
+                // x is in [0x84, 0x7FFF]: its top bit is bit 7..14.
+                int exponent = 7;
+                for (std::int32_t mask = 0x4000; (x & mask) == 0 && exponent > 0; mask >>= 1)
+                {
+                    --exponent;
+                }
+                const std::int32_t mantissa = (x >> (exponent + 3)) & 0x0F;
+                return static_cast<std::uint8_t>(~(sign | (exponent << 4) | mantissa));
+            }
+
+            std::int16_t mulawDecodeSample(std::uint8_t byte)
+            {
+                const std::int32_t u = static_cast<std::uint8_t>(~byte);
+                const std::int32_t exponent = (u >> 4) & 0x07;
+                const std::int32_t magnitude = ((((u & 0x0F) << 3) + kMulawBias) << exponent) - kMulawBias;
+                return static_cast<std::int16_t>((u & 0x80) ? -magnitude : magnitude);
+            }
+
+            std::uint8_t alawEncodeSample(std::int16_t sample)
+            {
+                std::int32_t x = sample >> 3;
+                std::uint8_t mask = 0xD5;
+                if (x < 0)
+                {
+                    mask = 0x55;
+                    x = -x - 1;
+                }
+                // x <= 0xFFF, so the segment is at most 7.
+                int segment = 0;
+                while (segment < 7 && x >= (0x20 << segment))
+                {
+                    ++segment;
+                }
+                const std::int32_t mantissa = segment < 2 ? (x >> 1) & 0x0F : (x >> segment) & 0x0F;
+                return static_cast<std::uint8_t>(((segment << 4) | mantissa) ^ mask);
+            }
+
+            std::int16_t alawDecodeSample(std::uint8_t byte)
+            {
+                const std::int32_t a = byte ^ 0x55;
+                std::int32_t t = (a & 0x0F) << 4;
+                const std::int32_t segment = (a & 0x70) >> 4;
+                if (segment == 0)
+                {
+                    t += 8;
+                }
+                else
+                {
+                    t = (t + 0x108) << (segment - 1);
+                }
+                return static_cast<std::int16_t>((a & 0x80) ? t : -t);
+            }
+
+            using DecodeTable = std::array<std::int16_t, 256>;
+
+            DecodeTable makeTable(std::int16_t (*decode)(std::uint8_t))
+            {
+                DecodeTable table{};
+                for (int i = 0; i < 256; ++i)
+                {
+                    table[i] = decode(static_cast<std::uint8_t>(i));
+                }
+                return table;
+            }
+
+            const DecodeTable kMulawTable = makeTable(mulawDecodeSample);
+            const DecodeTable kAlawTable = makeTable(alawDecodeSample);
+
+            void decode(const DecodeTable &table, const std::uint8_t *in, std::int16_t *out, std::size_t count)
+            {
+                for (std::size_t i = 0; i < count; ++i)
+                {
+                    out[i] = table[in[i]];
+                }
+            }
+
+            // The vector encoders find the segment without a loop: converted
+            // to float, a magnitude's exponent field is the index of its top
+            // bit, and the next four mantissa bits are exactly the G.711
+            // mantissa.
+#if defined(DEEPGRAMPP_G711_SSE2)
+            inline __m128i select(__m128i mask, __m128i a, __m128i b)
+            {
+                return _mm_or_si128(_mm_and_si128(mask, a), _mm_andnot_si128(mask, b));
+            }
+
+            inline __m128i mulawEncode4(__m128i x)
+            {
+                const __m128i sign = _mm_srai_epi32(x, 31);
+                __m128i magnitude = _mm_sub_epi32(_mm_xor_si128(x, sign), sign);
+                const __m128i clip = _mm_set1_epi32(kMulawClip);
+                magnitude = select(_mm_cmpgt_epi32(magnitude, clip), clip, magnitude);
+                magnitude = _mm_add_epi32(magnitude, _mm_set1_epi32(kMulawBias));
+                const __m128i bits = _mm_castps_si128(_mm_cvtepi32_ps(magnitude));
+                const __m128i exponent = _mm_sub_epi32(_mm_srli_epi32(bits, 23), _mm_set1_epi32(127 + 7));
+                const __m128i mantissa = _mm_and_si128(_mm_srli_epi32(bits, 19), _mm_set1_epi32(0x0F));
+                const __m128i code = _mm_or_si128(_mm_or_si128(_mm_and_si128(sign, _mm_set1_epi32(0x80)), _mm_slli_epi32(exponent, 4)), mantissa);
+                return _mm_xor_si128(code, _mm_set1_epi32(0xFF));
+            }
+
+            inline __m128i alawEncode4(__m128i x)
+            {
+                x = _mm_srai_epi32(x, 3);
+                const __m128i negative = _mm_srai_epi32(x, 31);
+                const __m128i magnitude = _mm_xor_si128(x, negative); // -x - 1 when negative
+                const __m128i bits = _mm_castps_si128(_mm_cvtepi32_ps(magnitude));
+                const __m128i small = _mm_cmplt_epi32(magnitude, _mm_set1_epi32(32));
+                const __m128i segment = select(small, _mm_setzero_si128(), _mm_sub_epi32(_mm_srli_epi32(bits, 23), _mm_set1_epi32(127 + 4)));
+                const __m128i mantissa = select(small, _mm_srli_epi32(magnitude, 1), _mm_srli_epi32(bits, 19));
+                const __m128i code = _mm_or_si128(_mm_slli_epi32(segment, 4), _mm_and_si128(mantissa, _mm_set1_epi32(0x0F)));
+                const __m128i mask = select(negative, _mm_set1_epi32(0x55), _mm_set1_epi32(0xD5));
+                return _mm_xor_si128(code, mask);
+            }
+
+            template <__m128i (*Encode4)(__m128i), std::uint8_t (*EncodeSample)(std::int16_t)>
+            void encode(const std::int16_t *in, std::uint8_t *out, std::size_t count)
+            {
+                std::size_t i = 0;
+                for (; i + 8 <= count; i += 8)
+                {
+                    const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(in + i));
+                    const __m128i lo = Encode4(_mm_srai_epi32(_mm_unpacklo_epi16(v, v), 16));
+                    const __m128i hi = Encode4(_mm_srai_epi32(_mm_unpackhi_epi16(v, v), 16));
+                    const __m128i bytes = _mm_packus_epi16(_mm_packs_epi32(lo, hi), _mm_setzero_si128());
+                    _mm_storel_epi64(reinterpret_cast<__m128i *>(out + i), bytes);
+                }
+                for (; i < count; ++i)
+                {
+                    out[i] = EncodeSample(in[i]);
+                }
+            }
+#elif defined(DEEPGRAMPP_G711_NEON)
+            inline int32x4_t mulawEncode4(int32x4_t x)
+            {
+                const int32x4_t sign = vshrq_n_s32(x, 31);
+                int32x4_t magnitude = vminq_s32(vabsq_s32(x), vdupq_n_s32(kMulawClip));
+                magnitude = vaddq_s32(magnitude, vdupq_n_s32(kMulawBias));
+                const uint32x4_t bits = vreinterpretq_u32_f32(vcvtq_f32_s32(magnitude));
+                const int32x4_t exponent = vsubq_s32(vreinterpretq_s32_u32(vshrq_n_u32(bits, 23)), vdupq_n_s32(127 + 7));
+                const int32x4_t mantissa = vreinterpretq_s32_u32(vandq_u32(vshrq_n_u32(bits, 19), vdupq_n_u32(0x0F)));
+                const int32x4_t code = vorrq_s32(vorrq_s32(vandq_s32(sign, vdupq_n_s32(0x80)), vshlq_n_s32(exponent, 4)), mantissa);
+                return veorq_s32(code, vdupq_n_s32(0xFF));
+            }
+
+            inline int32x4_t alawEncode4(int32x4_t x)
+            {
+                x = vshrq_n_s32(x, 3);
+                const int32x4_t negative = vshrq_n_s32(x, 31);
+                const int32x4_t magnitude = veorq_s32(x, negative);
+                const uint32x4_t bits = vreinterpretq_u32_f32(vcvtq_f32_s32(magnitude));
+                const uint32x4_t small = vcltq_s32(magnitude, vdupq_n_s32(32));
+                const int32x4_t segment = vbslq_s32(small, vdupq_n_s32(0), vsubq_s32(vreinterpretq_s32_u32(vshrq_n_u32(bits, 23)), vdupq_n_s32(127 + 4)));
+                const int32x4_t mantissa = vbslq_s32(small, vshrq_n_s32(magnitude, 1), vreinterpretq_s32_u32(vshrq_n_u32(bits, 19)));
+                const int32x4_t code = vorrq_s32(vshlq_n_s32(segment, 4), vandq_s32(mantissa, vdupq_n_s32(0x0F)));
+                const int32x4_t mask = vbslq_s32(vreinterpretq_u32_s32(negative), vdupq_n_s32(0x55), vdupq_n_s32(0xD5));
+                return veorq_s32(code, mask);
+            }
+
+            template <int32x4_t (*Encode4)(int32x4_t), std::uint8_t (*EncodeSample)(std::int16_t)>
+            void encode(const std::int16_t *in, std::uint8_t *out, std::size_t count)
+            {
+                std::size_t i = 0;
+                for (; i + 8 <= count; i += 8)
+                {
+                    const int16x8_t v = vld1q_s16(in + i);
+                    const int32x4_t lo = Encode4(vmovl_s16(vget_low_s16(v)));
+                    const int32x4_t hi = Encode4(vmovl_s16(vget_high_s16(v)));
+                    vst1_u8(out + i, vqmovun_s16(vcombine_s16(vmovn_s32(lo), vmovn_s32(hi))));
+                }
+                for (; i < count; ++i)
+                {
+                    out[i] = EncodeSample(in[i]);
+                }
+            }
+#else
+            template <std::uint8_t (*EncodeSample)(std::int16_t)>
+            void encode(const std::int16_t *in, std::uint8_t *out, std::size_t count)
+            {
+                for (std::size_t i = 0; i < count; ++i)
+                {
+                    out[i] = EncodeSample(in[i]);
+                }
+            }
+#endif
+        }
+
+        void mulawEncode(const std::int16_t *in, std::uint8_t *out, std::size_t count)
+        {
+#if defined(DEEPGRAMPP_G711_SSE2) || defined(DEEPGRAMPP_G711_NEON)
+            encode<mulawEncode4, mulawEncodeSample>(in, out, count);
+#else
+            encode<mulawEncodeSample>(in, out, count);
+#endif
+        }
+
+        void alawEncode(const std::int16_t *in, std::uint8_t *out, std::size_t count)
+        {
+#if defined(DEEPGRAMPP_G711_SSE2) || defined(DEEPGRAMPP_G711_NEON)
+            encode<alawEncode4, alawEncodeSample>(in, out, count);
+#else
+            encode<alawEncodeSample>(in, out, count);
+#endif
+        }
+
+        void mulawDecode(const std::uint8_t *in, std::int16_t *out, std::size_t count)
+        {
+            decode(kMulawTable, in, out, count);
+        }
+
+        void alawDecode(const std::uint8_t *in, std::int16_t *out, std::size_t count)
+        {
+            decode(kAlawTable, in, out, count);
+        }
+
+        AudioFormat G711Encoder::configure(const AudioFormat &input, const AudioFormat &wire)
+        {
+            _output = input;
+            _passThrough = true;
+            _carrying = false;
+            if (wire.sampleFormat != SampleFormat::Mulaw && wire.sampleFormat != SampleFormat::Alaw)
+            {
+                return _output;
+            }
+            if (input.sampleFormat != SampleFormat::Int16 || input.planar)
+            {
+                spdlog::warn("G711Encoder needs interleaved int16, passing {} through", toString(input));
+                return _output;
+            }
+            _output.sampleFormat = wire.sampleFormat;
+            _passThrough = false;
+            return _output;
+        }
+
+        void G711Encoder::process(const std::uint8_t *data, std::size_t size, std::vector<std::uint8_t> &out)
+        {
+            if (_passThrough)
+            {
+                out.insert(out.end(), data, data + size);
+                return;
+            }
+            const bool mulaw = _output.sampleFormat == SampleFormat::Mulaw;
+            if (_carrying && size > 0)
+            {
+                const std::uint8_t bytes[2] = {_carry, data[0]};
+                std::int16_t sample;
+                std::memcpy(&sample, bytes, sizeof(sample));
+                out.push_back(mulaw ? mulawEncodeSample(sample) : alawEncodeSample(sample));
+                _carrying = false;
+                ++data;
+                --size;
+            }
+
+            const std::size_t count = size / sizeof(std::int16_t);
+            const std::int16_t *samples = reinterpret_cast<const std::int16_t *>(data);
+            if (reinterpret_cast<std::uintptr_t>(data) % alignof(std::int16_t) != 0)
+            {
+                _staging.resize(count);
+                std::memcpy(_staging.data(), data, count * sizeof(std::int16_t));
+                samples = _staging.data();
+            }
+            const std::size_t offset = out.size();
+            out.resize(offset + count);
+            if (mulaw)
+            {
+                mulawEncode(samples, out.data() + offset, count);
+            }
+            else
+            {
+                alawEncode(samples, out.data() + offset, count);
+            }
+
+            if (size % sizeof(std::int16_t) != 0)
+            {
+                _carry = data[size - 1];
+                _carrying = true;
+            }
+        }
+    }
+}
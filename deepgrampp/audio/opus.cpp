@@ -0,0 +1,322 @@
+#include <deepgrampp/audio/opus.hpp>
+
+#include <opus.h>
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstring>
+
+namespace deepgram
+{
+    namespace audio
+    {
+        namespace
+        {
+            // RFC 6716: a packet is at most 1275 bytes per frame, and a 60 ms
+            // packet holds up to three 20 ms frames.
+            constexpr std::size_t kMaxPacketBytes = 4000;
+            constexpr int kGranuleRate = 48000;
+            constexpr const char *kVendor = "deepgrampp";
+
+            // Ogg's CRC-32: polynomial 0x04C11DB7, not reflected, no final xor.
+            const std::array<std::uint32_t, 256> &crcTable()
+            {
+                static const std::array<std::uint32_t, 256> table = []()
+                {
+                    std::array<std::uint32_t, 256> t{};
+                    for (std::uint32_t i = 0; i < 256; ++i)
+                    {
+                        std::uint32_t r = i << 24;
+                        for (int bit = 0; bit < 8; ++bit)
+                        {
+                            r = (r & 0x80000000u) ? (r << 1) ^ 0x04C11DB7u : r << 1;
+                        }
+                        t[i] = r;
+                    }
+                    return t;
+                }();
+                return table;
+            }
+
+            std::uint32_t oggCrc(const std::uint8_t *data, std::size_t size)
+            {
+                const std::array<std::uint32_t, 256> &table = crcTable();
+                std::uint32_t crc = 0;
+                for (std::size_t i = 0; i < size; ++i)
+                {
+                    crc = (crc << 8) ^ table[((crc >> 24) ^ data[i]) & 0xFF];
+                }
+                return crc;
+            }
+
+            template <typename T>
+            void putLe(std::vector<std::uint8_t> &out, T value, std::size_t bytes = sizeof(T))
+            {
+                for (std::size_t i = 0; i < bytes; ++i)
+                {
+                    out.push_back(static_cast<std::uint8_t>(static_cast<std::uint64_t>(value) >> (8 * i)));
+                }
+            }
+
+            // Lacing values a packet takes in a page's segment table.
+            std::size_t segmentsFor(std::size_t packet)
+            {
+                return packet / 255 + 1;
+            }
+        }
+
+        OpusEncoderStage::OpusEncoderStage(OpusEncoderOptions options) : _options(options) {}
+
+        OpusEncoderStage::~OpusEncoderStage()
+        {
+            if (_encoder)
+            {
+                opus_encoder_destroy(_encoder);
+            }
+        }
+
+        bool OpusEncoderStage::supportsRate(int sampleRate)
+        {
+            return sampleRate == 8000 || sampleRate == 12000 || sampleRate == 16000 || sampleRate == 24000 || sampleRate == 48000;
+        }
+
+        const char *OpusEncoderStage::encoding() const
+        {
+            return _options.container == OpusContainer::Ogg ? "ogg-opus" : "opus";
+        }
+
+        AudioFormat OpusEncoderStage::configure(const AudioFormat &input, const AudioFormat &wire)
+        {
+            (void)wire;
+            _input = input;
+            _passThrough = true;
+            _pending.clear();
+            _headersWritten = false;
+            _pageSequence = 0;
+            _granule = 0;
+            _serial = static_cast<std::uint32_t>(std::chrono::steady_clock::now().time_since_epoch().count() ^
+                                                 reinterpret_cast<std::uintptr_t>(this));
+            if (_encoder)
+            {
+                opus_encoder_destroy(_encoder);
+                _encoder = nullptr;
+            }
+
+            const bool pcm = input.sampleFormat == SampleFormat::Int16 || input.sampleFormat == SampleFormat::Float32;
+            if (!pcm || input.planar || input.channels < 1 || input.channels > 2 || !supportsRate(input.sampleRate))
+            {
+                spdlog::warn("OpusEncoderStage can't encode {}, passing it through", toString(input));
+                return input;
+            }
+
+            const long long frameMs = _options.frameDuration.count();
+            if (frameMs != 10 && frameMs != 20 && frameMs != 40 && frameMs != 60)
+            {
+                spdlog::warn("Opus frames can't be {} ms, using 20 ms", frameMs);
+                _options.frameDuration = std::chrono::milliseconds(20);
+            }
+
+            int error = OPUS_OK;
+            _encoder = opus_encoder_create(input.sampleRate, input.channels, OPUS_APPLICATION_VOIP, &error);
+            if (error != OPUS_OK || !_encoder)
+            {
+                spdlog::error("can't create Opus encoder: {}", opus_strerror(error));
+                _encoder = nullptr;
+                return input;
+            }
+            opus_encoder_ctl(_encoder, OPUS_SET_BITRATE(_options.bitrate));
+            opus_encoder_ctl(_encoder, OPUS_SET_COMPLEXITY(std::min(std::max(_options.complexity, 0), 10)));
+            opus_encoder_ctl(_encoder, OPUS_SET_SIGNAL(OPUS_SIGNAL_VOICE));
+            opus_int32 lookahead = 0;
+            opus_encoder_ctl(_encoder, OPUS_GET_LOOKAHEAD(&lookahead));
+            _preSkip = static_cast<int>(lookahead) * (kGranuleRate / input.sampleRate);
+
+            _frameSamples = input.sampleRate * static_cast<int>(_options.frameDuration.count()) / 1000;
+            _frameBytes = static_cast<std::size_t>(_frameSamples) * input.bytesPerFrame();
+            _pending.reserve(_frameBytes);
+            const std::size_t samples = static_cast<std::size_t>(_frameSamples) * static_cast<std::size_t>(input.channels);
+            _pcm16.resize(input.sampleFormat == SampleFormat::Int16 ? samples : 0);
+            _pcmFloat.resize(input.sampleFormat == SampleFormat::Float32 ? samples : 0);
+            _passThrough = false;
+
+            AudioFormat output = input;
+            output.sampleFormat = SampleFormat::Encoded;
+            return output;
+        }
+
+        void OpusEncoderStage::process(const std::uint8_t *data, std::size_t size, std::vector<std::uint8_t> &out)
+        {
+            if (_passThrough)
+            {
+                out.insert(out.end(), data, data + size);
+                return;
+            }
+            _packets.clear();
+            _packetSizes.clear();
+            while (size > 0)
+            {
+                if (!_pending.empty() || size < _frameBytes)
+                {
+                    const std::size_t take = std::min(_frameBytes - _pending.size(), size);
+                    _pending.insert(_pending.end(), data, data + take);
+                    data += take;
+                    size -= take;
+                    if (_pending.size() == _frameBytes)
+                    {
+                        encodeFrame(_pending.data());
+                        _pending.clear();
+                    }
+                }
+                else
+                {
+                    encodeFrame(data);
+                    data += _frameBytes;
+                    size -= _frameBytes;
+                }
+            }
+            writePackets(out);
+        }
+
+        void OpusEncoderStage::flush(std::vector<std::uint8_t> &out)
+        {
+            if (_passThrough || _pending.empty())
+            {
+                return;
+            }
+            _packets.clear();
+            _packetSizes.clear();
+            _pending.resize(_frameBytes, 0); // all-zero bytes are silence in both formats
+            encodeFrame(_pending.data());
+            _pending.clear();
+            writePackets(out);
+        }
+
+        void OpusEncoderStage::encodeFrame(const std::uint8_t *frame)
+        {
+            const std::size_t offset = _packets.size();
+            _packets.resize(offset + kMaxPacketBytes);
+            int bytes;
+            if (_input.sampleFormat == SampleFormat::Int16)
+            {
+                std::memcpy(_pcm16.data(), frame, _frameBytes);
+                bytes = opus_encode(_encoder, _pcm16.data(), _frameSamples, _packets.data() + offset, static_cast<opus_int32>(kMaxPacketBytes));
+            }
+            else
+            {
+                std::memcpy(_pcmFloat.data(), frame, _frameBytes);
+                bytes = opus_encode_float(_encoder, _pcmFloat.data(), _frameSamples, _packets.data() + offset, static_cast<opus_int32>(kMaxPacketBytes));
+            }
+            if (bytes < 0)
+            {
+                spdlog::error("Opus encoding failed: {}", opus_strerror(bytes));
+                _packets.resize(offset);
+                return;
+            }
+            _packets.resize(offset + static_cast<std::size_t>(bytes));
+            _packetSizes.push_back(static_cast<std::size_t>(bytes));
+            _granule += static_cast<std::int64_t>(_frameSamples) * (kGranuleRate / _input.sampleRate);
+        }
+
+        void OpusEncoderStage::writePackets(std::vector<std::uint8_t> &out)
+        {
+            if (_options.container == OpusContainer::Raw)
+            {
+                const std::uint8_t *packet = _packets.data();
+                for (const std::size_t size : _packetSizes)
+                {
+                    putLe(out, static_cast<std::uint16_t>(size));
+                    out.insert(out.end(), packet, packet + size);
+                    packet += size;
+                }
+                return;
+            }
+
+            if (!_headersWritten)
+            {
+                writeHeaders(out);
+            }
+            if (_packetSizes.empty())
+            {
+                return;
+            }
+            // A page's segment table holds at most 255 lacing values; packets
+            // are never split across pages. Every page but the last ends
+            // mid-call, so its granule position is back-dated by the packets
+            // that follow it.
+            const std::int64_t frameGranule = static_cast<std::int64_t>(_frameSamples) * (kGranuleRate / _input.sampleRate);
+            std::vector<std::size_t> page;
+            std::size_t segments = 0;
+            const std::uint8_t *pageData = _packets.data();
+            const std::uint8_t *next = pageData;
+            for (std::size_t i = 0; i < _packetSizes.size(); ++i)
+            {
+                if (segments + segmentsFor(_packetSizes[i]) > 255)
+                {
+                    const std::int64_t remaining = static_cast<std::int64_t>(_packetSizes.size() - i);
+                    writePage(0, pageData, page, _granule - remaining * frameGranule, out);
+                    page.clear();
+                    segments = 0;
+                    pageData = next;
+                }
+                page.push_back(_packetSizes[i]);
+                segments += segmentsFor(_packetSizes[i]);
+                next += _packetSizes[i];
+            }
+            writePage(0, pageData, page, _granule, out);
+        }
+
+        void OpusEncoderStage::writeHeaders(std::vector<std::uint8_t> &out)
+        {
+            std::vector<std::uint8_t> head;
+            head.insert(head.end(), {'O', 'p', 'u', 's', 'H', 'e', 'a', 'd', 1});
+            head.push_back(static_cast<std::uint8_t>(_input.channels));
+            putLe(head, static_cast<std::uint16_t>(_preSkip));
+            putLe(head, static_cast<std::uint32_t>(_input.sampleRate));
+            putLe(head, static_cast<std::int16_t>(0)); // output gain
+            head.push_back(0);                         // mapping family: mono/stereo
+            writePage(0x02, head.data(), {head.size()}, 0, out);
+
+            std::vector<std::uint8_t> tags;
+            tags.insert(tags.end(), {'O', 'p', 'u', 's', 'T', 'a', 'g', 's'});
+            const std::size_t vendorLength = std::strlen(kVendor);
+            putLe(tags, static_cast<std::uint32_t>(vendorLength));
+            tags.insert(tags.end(), kVendor, kVendor + vendorLength);
+            putLe(tags, static_cast<std::uint32_t>(0)); // no user comments
+            writePage(0, tags.data(), {tags.size()}, 0, out);
+            _headersWritten = true;
+        }
+
+        void OpusEncoderStage::writePage(std::uint8_t headerType, const std::uint8_t *data, const std::vector<std::size_t> &packets,
+                                         std::int64_t granule, std::vector<std::uint8_t> &out)
+        {
+            const std::size_t start = out.size();
+            out.insert(out.end(), {'O', 'g', 'g', 'S', 0, headerType});
+            putLe(out, granule);
+            putLe(out, _serial);
+            putLe(out, _pageSequence++);
+            putLe(out, static_cast<std::uint32_t>(0)); // CRC, filled in below
+            std::size_t segments = 0;
+            std::size_t bytes = 0;
+            for (const std::size_t packet : packets)
+            {
+                segments += segmentsFor(packet);
+                bytes += packet;
+            }
+            out.push_back(static_cast<std::uint8_t>(segments));
+            for (const std::size_t packet : packets)
+            {
+                out.insert(out.end(), packet / 255, 255);
+                out.push_back(static_cast<std::uint8_t>(packet % 255));
+            }
+            out.insert(out.end(), data, data + bytes);
+
+            const std::uint32_t crc = oggCrc(out.data() + start, out.size() - start);
+            for (int i = 0; i < 4; ++i)
+            {
+                out[start + 22 + i] = static_cast<std::uint8_t>(crc >> (8 * i));
+            }
+        }
+    }
+}
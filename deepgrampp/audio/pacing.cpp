@@ -0,0 +1,66 @@
+#include <deepgrampp/audio/pacing.hpp>
+
+#include <algorithm>
+#include <thread>
+
+namespace deepgram
+{
+    namespace audio
+    {
+        std::size_t bytesPerSampleFrame(const std::string &encoding, int channels)
+        {
+            if (channels <= 0)
+            {
+                return 0;
+            }
+            std::size_t bytesPerSample = 0;
+            if (encoding == "linear16")
+            {
+                bytesPerSample = 2;
+            }
+            else if (encoding == "linear32")
+            {
+                bytesPerSample = 4;
+            }
+            else if (encoding == "mulaw" || encoding == "alaw")
+            {
+                bytesPerSample = 1;
+            }
+            return bytesPerSample * static_cast<std::size_t>(channels);
+        }
+
+        bool streamPaced(const std::uint8_t *data, std::size_t size,
+                         std::size_t bytesPerSecond, std::size_t bytesPerSampleFrame,
+                         const PacingOptions &options,
+                         const std::function<bool(const std::uint8_t *, std::size_t)> &sendFrame)
+        {
+            if (bytesPerSecond == 0 || bytesPerSampleFrame == 0)
+            {
+                return false;
+            }
+            const auto frameDuration = std::max(options.frameDuration, std::chrono::milliseconds(1));
+            // Whole sample frames only, so no frame ever splits a sample.
+            std::size_t frameBytes = bytesPerSecond * static_cast<std::size_t>(frameDuration.count()) / 1000;
+            frameBytes = std::max(bytesPerSampleFrame, frameBytes / bytesPerSampleFrame * bytesPerSampleFrame);
+
+            const bool paced = options.speed > 0.0;
+            const double secondsPerByte = paced ? 1.0 / (static_cast<double>(bytesPerSecond) * options.speed) : 0.0;
+            const auto start = std::chrono::steady_clock::now();
+
+            for (std::size_t offset = 0; offset < size; offset += frameBytes)
+            {
+                if (paced && offset > 0)
+                {
+                    // Due when the audio before it would have finished playing.
+                    const std::chrono::duration<double> due(static_cast<double>(offset) * secondsPerByte);
+                    std::this_thread::sleep_until(start + std::chrono::duration_cast<std::chrono::steady_clock::duration>(due));
+                }
+                if (!sendFrame(data + offset, std::min(frameBytes, size - offset)))
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+    }
+}
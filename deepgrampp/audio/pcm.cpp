@@ -0,0 +1,765 @@
+#include <deepgrampp/audio/pcm.hpp>
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#define DEEPGRAMPP_PCM_SSE2 1
+#include <immintrin.h>
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+// AVX2 kernels are compiled per function and only run after a CPU check, so
+// the library itself still targets baseline x86-64.
+#define DEEPGRAMPP_PCM_AVX2 1
+#endif
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#define DEEPGRAMPP_PCM_NEON 1
+#include <arm_neon.h>
+#endif
+
+namespace deepgram
+{
+    namespace audio
+    {
+        namespace
+        {
+            // int16 <-> float uses a 2^15 scale, so +1.0 clips to 32767 and
+            // int16 -> float -> int16 round-trips exactly.
+            constexpr float kInt16Scale = 32768.0f;
+            constexpr float kInt16Min = -32768.0f;
+            constexpr float kInt16Max = 32767.0f;
+            constexpr float kInt32Scale = 2147483648.0f;
+            constexpr float kInt32Min = -2147483648.0f;
+            // Largest float below 2^31.
+            constexpr float kInt32Max = 2147483520.0f;
+            constexpr float kDitherScale = 1.0f / 65536.0f;
+
+            // The scalar kernels spell out clamping as (v > lo ? v : lo) and
+            // round with lrint so they match the vector max/min/convert
+            // instructions bit for bit, NaN included.
+            inline float clampTo(float v, float lo, float hi)
+            {
+                v = v > lo ? v : lo;
+                return v < hi ? v : hi;
+            }
+
+            inline std::uint32_t xorshift(std::uint32_t s)
+            {
+                s ^= s << 13;
+                s ^= s >> 17;
+                s ^= s << 5;
+                return s;
+            }
+
+            // Difference of two uniform 16-bit values: triangular over (-1, 1).
+            inline float ditherOf(std::uint32_t s)
+            {
+                return static_cast<float>(static_cast<std::int32_t>(s & 0xFFFFu) - static_cast<std::int32_t>(s >> 16)) * kDitherScale;
+            }
+
+            void scalarInt16ToFloat(const std::int16_t *in, float *out, std::size_t count)
+            {
+                for (std::size_t i = 0; i < count; ++i)
+                {
+                    out[i] = static_cast<float>(in[i]) * (1.0f / kInt16Scale);
+                }
+            }
+
+            void scalarInt32ToFloat(const std::int32_t *in, float *out, std::size_t count)
+            {
+                for (std::size_t i = 0; i < count; ++i)
+                {
+                    out[i] = static_cast<float>(in[i]) * (1.0f / kInt32Scale);
+                }
+            }
+
+            void scalarFloatToInt16(const float *in, std::int16_t *out, std::size_t count, DitherState *dither)
+            {
+                for (std::size_t i = 0; i < count; ++i)
+                {
+                    float v = in[i] * kInt16Scale;
+                    if (dither)
+                    {
+                        std::uint32_t &lane = dither->lanes[i & 7];
+                        lane = xorshift(lane);
+                        v = v + ditherOf(lane);
+                    }
+                    out[i] = static_cast<std::int16_t>(std::lrint(clampTo(v, kInt16Min, kInt16Max)));
+                }
+            }
+
+            void scalarFloatToInt32(const float *in, std::int32_t *out, std::size_t count)
+            {
+                for (std::size_t i = 0; i < count; ++i)
+                {
+                    out[i] = static_cast<std::int32_t>(std::lrint(clampTo(in[i] * kInt32Scale, kInt32Min, kInt32Max)));
+                }
+            }
+
+            void scalarInterleave(const float *const *planes, int channels, std::size_t frames, float *out)
+            {
+                for (std::size_t f = 0; f < frames; ++f)
+                {
+                    for (int c = 0; c < channels; ++c)
+                    {
+                        *out++ = planes[c][f];
+                    }
+                }
+            }
+
+            void scalarDeinterleave(const float *in, int channels, std::size_t frames, float *const *planes)
+            {
+                for (std::size_t f = 0; f < frames; ++f)
+                {
+                    for (int c = 0; c < channels; ++c)
+                    {
+                        planes[c][f] = *in++;
+                    }
+                }
+            }
+
+            void scalarDownmix(const float *in, int channels, std::size_t frames, float *out)
+            {
+                const float scale = 1.0f / static_cast<float>(channels);
+                for (std::size_t f = 0; f < frames; ++f)
+                {
+                    float sum = 0.0f;
+                    for (int c = 0; c < channels; ++c)
+                    {
+                        sum += *in++;
+                    }
+                    out[f] = sum * scale;
+                }
+            }
+
+#if defined(DEEPGRAMPP_PCM_SSE2)
+            inline __m128i xorshift(__m128i s)
+            {
+                s = _mm_xor_si128(s, _mm_slli_epi32(s, 13));
+                s = _mm_xor_si128(s, _mm_srli_epi32(s, 17));
+                return _mm_xor_si128(s, _mm_slli_epi32(s, 5));
+            }
+
+            inline __m128 ditherOf(__m128i s)
+            {
+                const __m128i diff = _mm_sub_epi32(_mm_and_si128(s, _mm_set1_epi32(0xFFFF)), _mm_srli_epi32(s, 16));
+                return _mm_mul_ps(_mm_cvtepi32_ps(diff), _mm_set1_ps(kDitherScale));
+            }
+
+            void sse2Int16ToFloat(const std::int16_t *in, float *out, std::size_t count)
+            {
+                const __m128 scale = _mm_set1_ps(1.0f / kInt16Scale);
+                std::size_t i = 0;
+                for (; i + 8 <= count; i += 8)
+                {
+                    const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(in + i));
+                    // Widen with sign: put each sample in the high half, shift down.
+                    const __m128i lo = _mm_srai_epi32(_mm_unpacklo_epi16(v, v), 16);
+                    const __m128i hi = _mm_srai_epi32(_mm_unpackhi_epi16(v, v), 16);
+                    _mm_storeu_ps(out + i, _mm_mul_ps(_mm_cvtepi32_ps(lo), scale));
+                    _mm_storeu_ps(out + i + 4, _mm_mul_ps(_mm_cvtepi32_ps(hi), scale));
+                }
+                scalarInt16ToFloat(in + i, out + i, count - i);
+            }
+
+            void sse2Int32ToFloat(const std::int32_t *in, float *out, std::size_t count)
+            {
+                const __m128 scale = _mm_set1_ps(1.0f / kInt32Scale);
+                std::size_t i = 0;
+                for (; i + 4 <= count; i += 4)
+                {
+                    const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(in + i));
+                    _mm_storeu_ps(out + i, _mm_mul_ps(_mm_cvtepi32_ps(v), scale));
+                }
+                scalarInt32ToFloat(in + i, out + i, count - i);
+            }
+
+            void sse2FloatToInt16(const float *in, std::int16_t *out, std::size_t count, DitherState *dither)
+            {
+                const __m128 scale = _mm_set1_ps(kInt16Scale);
+                const __m128 lo = _mm_set1_ps(kInt16Min);
+                const __m128 hi = _mm_set1_ps(kInt16Max);
+                __m128i s0 = _mm_setzero_si128();
+                __m128i s1 = _mm_setzero_si128();
+                if (dither)
+                {
+                    s0 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(dither->lanes));
+                    s1 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(dither->lanes + 4));
+                }
+                std::size_t i = 0;
+                for (; i + 8 <= count; i += 8)
+                {
+                    __m128 a = _mm_mul_ps(_mm_loadu_ps(in + i), scale);
+                    __m128 b = _mm_mul_ps(_mm_loadu_ps(in + i + 4), scale);
+                    if (dither)
+                    {
+                        s0 = xorshift(s0);
+                        s1 = xorshift(s1);
+                        a = _mm_add_ps(a, ditherOf(s0));
+                        b = _mm_add_ps(b, ditherOf(s1));
+                    }
+                    a = _mm_min_ps(_mm_max_ps(a, lo), hi);
+                    b = _mm_min_ps(_mm_max_ps(b, lo), hi);
+                    _mm_storeu_si128(reinterpret_cast<__m128i *>(out + i), _mm_packs_epi32(_mm_cvtps_epi32(a), _mm_cvtps_epi32(b)));
+                }
+                if (dither)
+                {
+                    _mm_storeu_si128(reinterpret_cast<__m128i *>(dither->lanes), s0);
+                    _mm_storeu_si128(reinterpret_cast<__m128i *>(dither->lanes + 4), s1);
+                }
+                scalarFloatToInt16(in + i, out + i, count - i, dither);
+            }
+
+            void sse2FloatToInt32(const float *in, std::int32_t *out, std::size_t count)
+            {
+                const __m128 scale = _mm_set1_ps(kInt32Scale);
+                const __m128 lo = _mm_set1_ps(kInt32Min);
+                const __m128 hi = _mm_set1_ps(kInt32Max);
+                std::size_t i = 0;
+                for (; i + 4 <= count; i += 4)
+                {
+                    const __m128 v = _mm_min_ps(_mm_max_ps(_mm_mul_ps(_mm_loadu_ps(in + i), scale), lo), hi);
+                    _mm_storeu_si128(reinterpret_cast<__m128i *>(out + i), _mm_cvtps_epi32(v));
+                }
+                scalarFloatToInt32(in + i, out + i, count - i);
+            }
+
+            void sse2Interleave(const float *const *planes, int channels, std::size_t frames, float *out)
+            {
+                if (channels != 2)
+                {
+                    scalarInterleave(planes, channels, frames, out);
+                    return;
+                }
+                const float *l = planes[0];
+                const float *r = planes[1];
+                std::size_t f = 0;
+                for (; f + 4 <= frames; f += 4)
+                {
+                    const __m128 a = _mm_loadu_ps(l + f);
+                    const __m128 b = _mm_loadu_ps(r + f);
+                    _mm_storeu_ps(out + 2 * f, _mm_unpacklo_ps(a, b));
+                    _mm_storeu_ps(out + 2 * f + 4, _mm_unpackhi_ps(a, b));
+                }
+                const float *rest[2] = {l + f, r + f};
+                scalarInterleave(rest, 2, frames - f, out + 2 * f);
+            }
+
+            void sse2Deinterleave(const float *in, int channels, std::size_t frames, float *const *planes)
+            {
+                if (channels != 2)
+                {
+                    scalarDeinterleave(in, channels, frames, planes);
+                    return;
+                }
+                float *l = planes[0];
+                float *r = planes[1];
+                std::size_t f = 0;
+                for (; f + 4 <= frames; f += 4)
+                {
+                    const __m128 a = _mm_loadu_ps(in + 2 * f);
+                    const __m128 b = _mm_loadu_ps(in + 2 * f + 4);
+                    _mm_storeu_ps(l + f, _mm_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0)));
+                    _mm_storeu_ps(r + f, _mm_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1)));
+                }
+                float *rest[2] = {l + f, r + f};
+                scalarDeinterleave(in + 2 * f, 2, frames - f, rest);
+            }
+
+            void sse2Downmix(const float *in, int channels, std::size_t frames, float *out)
+            {
+                if (channels != 2)
+                {
+                    scalarDownmix(in, channels, frames, out);
+                    return;
+                }
+                const __m128 half = _mm_set1_ps(0.5f);
+                std::size_t f = 0;
+                for (; f + 4 <= frames; f += 4)
+                {
+                    const __m128 a = _mm_loadu_ps(in + 2 * f);
+                    const __m128 b = _mm_loadu_ps(in + 2 * f + 4);
+                    const __m128 l = _mm_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0));
+                    const __m128 r = _mm_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1));
+                    _mm_storeu_ps(out + f, _mm_mul_ps(_mm_add_ps(l, r), half));
+                }
+                scalarDownmix(in + 2 * f, 2, frames - f, out + f);
+            }
+#endif
+
+#if defined(DEEPGRAMPP_PCM_AVX2)
+            __attribute__((target("avx2"))) void avx2Int16ToFloat(const std::int16_t *in, float *out, std::size_t count)
+            {
+                const __m256 scale = _mm256_set1_ps(1.0f / kInt16Scale);
+                std::size_t i = 0;
+                for (; i + 8 <= count; i += 8)
+                {
+                    const __m256i v = _mm256_cvtepi16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i *>(in + i)));
+                    _mm256_storeu_ps(out + i, _mm256_mul_ps(_mm256_cvtepi32_ps(v), scale));
+                }
+                scalarInt16ToFloat(in + i, out + i, count - i);
+            }
+
+            __attribute__((target("avx2"))) void avx2Int32ToFloat(const std::int32_t *in, float *out, std::size_t count)
+            {
+                const __m256 scale = _mm256_set1_ps(1.0f / kInt32Scale);
+                std::size_t i = 0;
+                for (; i + 8 <= count; i += 8)
+                {
+                    const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(in + i));
+                    _mm256_storeu_ps(out + i, _mm256_mul_ps(_mm256_cvtepi32_ps(v), scale));
+                }
+                scalarInt32ToFloat(in + i, out + i, count - i);
+            }
+
+            __attribute__((target("avx2"))) void avx2FloatToInt16(const float *in, std::int16_t *out, std::size_t count, DitherState *dither)
+            {
+                const __m256 scale = _mm256_set1_ps(kInt16Scale);
+                const __m256 lo = _mm256_set1_ps(kInt16Min);
+                const __m256 hi = _mm256_set1_ps(kInt16Max);
+                const __m256i mask = _mm256_set1_epi32(0xFFFF);
+                const __m256 ditherScale = _mm256_set1_ps(kDitherScale);
+                __m256i s = _mm256_setzero_si256();
+                if (dither)
+                {
+                    s = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(dither->lanes));
+                }
+                std::size_t i = 0;
+                for (; i + 8 <= count; i += 8)
+                {
+                    __m256 v = _mm256_mul_ps(_mm256_loadu_ps(in + i), scale);
+                    if (dither)
+                    {
+                        s = _mm256_xor_si256(s, _mm256_slli_epi32(s, 13));
+                        s = _mm256_xor_si256(s, _mm256_srli_epi32(s, 17));
+                        s = _mm256_xor_si256(s, _mm256_slli_epi32(s, 5));
+                        const __m256i diff = _mm256_sub_epi32(_mm256_and_si256(s, mask), _mm256_srli_epi32(s, 16));
+                        v = _mm256_add_ps(v, _mm256_mul_ps(_mm256_cvtepi32_ps(diff), ditherScale));
+                    }
+                    const __m256i q = _mm256_cvtps_epi32(_mm256_min_ps(_mm256_max_ps(v, lo), hi));
+                    _mm_storeu_si128(reinterpret_cast<__m128i *>(out + i),
+                                     _mm_packs_epi32(_mm256_castsi256_si128(q), _mm256_extracti128_si256(q, 1)));
+                }
+                if (dither)
+                {
+                    _mm256_storeu_si256(reinterpret_cast<__m256i *>(dither->lanes), s);
+                }
+                scalarFloatToInt16(in + i, out + i, count - i, dither);
+            }
+
+            __attribute__((target("avx2"))) void avx2FloatToInt32(const float *in, std::int32_t *out, std::size_t count)
+            {
+                const __m256 scale = _mm256_set1_ps(kInt32Scale);
+                const __m256 lo = _mm256_set1_ps(kInt32Min);
+                const __m256 hi = _mm256_set1_ps(kInt32Max);
+                std::size_t i = 0;
+                for (; i + 8 <= count; i += 8)
+                {
+                    const __m256 v = _mm256_min_ps(_mm256_max_ps(_mm256_mul_ps(_mm256_loadu_ps(in + i), scale), lo), hi);
+                    _mm256_storeu_si256(reinterpret_cast<__m256i *>(out + i), _mm256_cvtps_epi32(v));
+                }
+                scalarFloatToInt32(in + i, out + i, count - i);
+            }
+#endif
+
+#if defined(DEEPGRAMPP_PCM_NEON)
+            inline uint32x4_t xorshift(uint32x4_t s)
+            {
+                s = veorq_u32(s, vshlq_n_u32(s, 13));
+                s = veorq_u32(s, vshrq_n_u32(s, 17));
+                return veorq_u32(s, vshlq_n_u32(s, 5));
+            }
+
+            inline float32x4_t ditherOf(uint32x4_t s)
+            {
+                const int32x4_t diff = vsubq_s32(vreinterpretq_s32_u32(vandq_u32(s, vdupq_n_u32(0xFFFFu))),
+                                                 vreinterpretq_s32_u32(vshrq_n_u32(s, 16)));
+                return vmulq_n_f32(vcvtq_f32_s32(diff), kDitherScale);
+            }
+
+            // vmaxq/vminq propagate NaN; select instead to match the x86 and
+            // scalar kernels.
+            inline float32x4_t clampTo(float32x4_t v, float32x4_t lo, float32x4_t hi)
+            {
+                v = vbslq_f32(vcgtq_f32(v, lo), v, lo);
+                return vbslq_f32(vcltq_f32(v, hi), v, hi);
+            }
+
+            void neonInt16ToFloat(const std::int16_t *in, float *out, std::size_t count)
+            {
+                std::size_t i = 0;
+                for (; i + 8 <= count; i += 8)
+                {
+                    const int16x8_t v = vld1q_s16(in + i);
+                    vst1q_f32(out + i, vmulq_n_f32(vcvtq_f32_s32(vmovl_s16(vget_low_s16(v))), 1.0f / kInt16Scale));
+                    vst1q_f32(out + i + 4, vmulq_n_f32(vcvtq_f32_s32(vmovl_s16(vget_high_s16(v))), 1.0f / kInt16Scale));
+                }
+                scalarInt16ToFloat(in + i, out + i, count - i);
+            }
+
+            void neonInt32ToFloat(const std::int32_t *in, float *out, std::size_t count)
+            {
+                std::size_t i = 0;
+                for (; i + 4 <= count; i += 4)
+                {
+                    vst1q_f32(out + i, vmulq_n_f32(vcvtq_f32_s32(vld1q_s32(in + i)), 1.0f / kInt32Scale));
+                }
+                scalarInt32ToFloat(in + i, out + i, count - i);
+            }
+
+            void neonFloatToInt16(const float *in, std::int16_t *out, std::size_t count, DitherState *dither)
+            {
+                const float32x4_t lo = vdupq_n_f32(kInt16Min);
+                const float32x4_t hi = vdupq_n_f32(kInt16Max);
+                uint32x4_t s0 = vdupq_n_u32(0);
+                uint32x4_t s1 = vdupq_n_u32(0);
+                if (dither)
+                {
+                    s0 = vld1q_u32(dither->lanes);
+                    s1 = vld1q_u32(dither->lanes + 4);
+                }
+                std::size_t i = 0;
+                for (; i + 8 <= count; i += 8)
+                {
+                    float32x4_t a = vmulq_n_f32(vld1q_f32(in + i), kInt16Scale);
+                    float32x4_t b = vmulq_n_f32(vld1q_f32(in + i + 4), kInt16Scale);
+                    if (dither)
+                    {
+                        s0 = xorshift(s0);
+                        s1 = xorshift(s1);
+                        a = vaddq_f32(a, ditherOf(s0));
+                        b = vaddq_f32(b, ditherOf(s1));
+                    }
+                    const int32x4_t qa = vcvtnq_s32_f32(clampTo(a, lo, hi));
+                    const int32x4_t qb = vcvtnq_s32_f32(clampTo(b, lo, hi));
+                    vst1q_s16(out + i, vcombine_s16(vqmovn_s32(qa), vqmovn_s32(qb)));
+                }
+                if (dither)
+                {
+                    vst1q_u32(dither->lanes, s0);
+                    vst1q_u32(dither->lanes + 4, s1);
+                }
+                scalarFloatToInt16(in + i, out + i, count - i, dither);
+            }
+
+            void neonFloatToInt32(const float *in, std::int32_t *out, std::size_t count)
+            {
+                const float32x4_t lo = vdupq_n_f32(kInt32Min);
+                const float32x4_t hi = vdupq_n_f32(kInt32Max);
+                std::size_t i = 0;
+                for (; i + 4 <= count; i += 4)
+                {
+                    vst1q_s32(out + i, vcvtnq_s32_f32(clampTo(vmulq_n_f32(vld1q_f32(in + i), kInt32Scale), lo, hi)));
+                }
+                scalarFloatToInt32(in + i, out + i, count - i);
+            }
+
+            void neonInterleave(const float *const *planes, int channels, std::size_t frames, float *out)
+            {
+                if (channels != 2)
+                {
+                    scalarInterleave(planes, channels, frames, out);
+                    return;
+                }
+                std::size_t f = 0;
+                for (; f + 4 <= frames; f += 4)
+                {
+                    float32x4x2_t v;
+                    v.val[0] = vld1q_f32(planes[0] + f);
+                    v.val[1] = vld1q_f32(planes[1] + f);
+                    vst2q_f32(out + 2 * f, v);
+                }
+                const float *rest[2] = {planes[0] + f, planes[1] + f};
+                scalarInterleave(rest, 2, frames - f, out + 2 * f);
+            }
+
+            void neonDeinterleave(const float *in, int channels, std::size_t frames, float *const *planes)
+            {
+                if (channels != 2)
+                {
+                    scalarDeinterleave(in, channels, frames, planes);
+                    return;
+                }
+                std::size_t f = 0;
+                for (; f + 4 <= frames; f += 4)
+                {
+                    const float32x4x2_t v = vld2q_f32(in + 2 * f);
+                    vst1q_f32(planes[0] + f, v.val[0]);
+                    vst1q_f32(planes[1] + f, v.val[1]);
+                }
+                float *rest[2] = {planes[0] + f, planes[1] + f};
+                scalarDeinterleave(in + 2 * f, 2, frames - f, rest);
+            }
+
+            void neonDownmix(const float *in, int channels, std::size_t frames, float *out)
+            {
+                if (channels != 2)
+                {
+                    scalarDownmix(in, channels, frames, out);
+                    return;
+                }
+                std::size_t f = 0;
+                for (; f + 4 <= frames; f += 4)
+                {
+                    const float32x4x2_t v = vld2q_f32(in + 2 * f);
+                    vst1q_f32(out + f, vmulq_n_f32(vaddq_f32(v.val[0], v.val[1]), 0.5f));
+                }
+                scalarDownmix(in + 2 * f, 2, frames - f, out + f);
+            }
+#endif
+
+            struct Kernels
+            {
+                const char *name;
+                void (*int16ToFloat)(const std::int16_t *, float *, std::size_t);
+                void (*int32ToFloat)(const std::int32_t *, float *, std::size_t);
+                void (*floatToInt16)(const float *, std::int16_t *, std::size_t, DitherState *);
+                void (*floatToInt32)(const float *, std::int32_t *, std::size_t);
+                void (*interleave)(const float *const *, int, std::size_t, float *);
+                void (*deinterleave)(const float *, int, std::size_t, float *const *);
+                void (*downmix)(const float *, int, std::size_t, float *);
+            };
+
+            Kernels selectKernels()
+            {
+#if defined(DEEPGRAMPP_PCM_AVX2)
+                if (__builtin_cpu_supports("avx2"))
+                {
+                    // Channel shuffles stay on SSE2: they're bound by memory,
+                    // and AVX2 shuffles don't cross 128-bit lanes.
+                    return {"avx2", avx2Int16ToFloat, avx2Int32ToFloat, avx2FloatToInt16, avx2FloatToInt32,
+                            sse2Interleave, sse2Deinterleave, sse2Downmix};
+                }
+#endif
+#if defined(DEEPGRAMPP_PCM_SSE2)
+                return {"sse2", sse2Int16ToFloat, sse2Int32ToFloat, sse2FloatToInt16, sse2FloatToInt32,
+                        sse2Interleave, sse2Deinterleave, sse2Downmix};
+#elif defined(DEEPGRAMPP_PCM_NEON)
+                return {"neon", neonInt16ToFloat, neonInt32ToFloat, neonFloatToInt16, neonFloatToInt32,
+                        neonInterleave, neonDeinterleave, neonDownmix};
+#else
+                return {"scalar", scalarInt16ToFloat, scalarInt32ToFloat, scalarFloatToInt16, scalarFloatToInt32,
+                        scalarInterleave, scalarDeinterleave, scalarDownmix};
+#endif
+            }
+
+            const Kernels &kernels()
+            {
+                static const Kernels selected = selectKernels();
+                return selected;
+            }
+
+            // Frames converted per pass, bounding the scratch buffers.
+            constexpr std::size_t kBlockFrames = 1024;
+        }
+
+        DitherState::DitherState(std::uint32_t seed)
+        {
+            for (std::uint32_t i = 0; i < 8; ++i)
+            {
+                // xorshift32 must not start at zero.
+                lanes[i] = xorshift(seed + 0x6D2B79F5u * (i + 1)) | 1u;
+            }
+        }
+
+        void int16ToFloat(const std::int16_t *in, float *out, std::size_t count)
+        {
+            kernels().int16ToFloat(in, out, count);
+        }
+
+        void int32ToFloat(const std::int32_t *in, float *out, std::size_t count)
+        {
+            kernels().int32ToFloat(in, out, count);
+        }
+
+        void floatToInt16(const float *in, std::int16_t *out, std::size_t count, DitherState *dither)
+        {
+            kernels().floatToInt16(in, out, count, dither);
+        }
+
+        void floatToInt32(const float *in, std::int32_t *out, std::size_t count)
+        {
+            kernels().floatToInt32(in, out, count);
+        }
+
+        void interleave(const float *const *planes, int channels, std::size_t frames, float *out)
+        {
+            kernels().interleave(planes, channels, frames, out);
+        }
+
+        void deinterleave(const float *in, int channels, std::size_t frames, float *const *planes)
+        {
+            kernels().deinterleave(in, channels, frames, planes);
+        }
+
+        void downmixToMono(const float *in, int channels, std::size_t frames, float *out)
+        {
+            if (channels > 0)
+            {
+                kernels().downmix(in, channels, frames, out);
+            }
+        }
+
+        const char *simdBackend()
+        {
+            return kernels().name;
+        }
+
+        PcmConverter::PcmConverter(PcmConverterOptions options) : _options(options) {}
+
+        AudioFormat PcmConverter::configure(const AudioFormat &input, const AudioFormat &wire)
+        {
+            _input = input;
+            _output = input;
+            _dither = DitherState();
+            _carry.clear();
+            if (!input.linear() || input.channels <= 0)
+            {
+                spdlog::warn("PcmConverter can't convert {}, passing it through", toString(input));
+                return _output;
+            }
+
+            _output.sampleFormat = wire.linear() ? wire.sampleFormat : SampleFormat::Int16;
+            _output.channels = wire.channels > 0 ? wire.channels : input.channels;
+            _output.planar = false;
+            if (_output.channels != input.channels && _output.channels != 1 && input.channels != 1)
+            {
+                spdlog::warn("PcmConverter maps {} channels to {} by position", input.channels, _output.channels);
+            }
+            return _output;
+        }
+
+        void PcmConverter::process(const std::uint8_t *data, std::size_t size, std::vector<std::uint8_t> &out)
+        {
+            if (_input == _output)
+            {
+                out.insert(out.end(), data, data + size);
+                return;
+            }
+
+            const std::size_t frameBytes = _input.bytesPerFrame();
+            if (_input.planar)
+            {
+                if (size % frameBytes != 0)
+                {
+                    spdlog::warn("PcmConverter dropped {} bytes of planar audio that aren't a whole frame", size % frameBytes);
+                }
+                convert(data, size / frameBytes, out);
+                return;
+            }
+
+            if (!_carry.empty())
+            {
+                const std::size_t take = std::min(frameBytes - _carry.size(), size);
+                _carry.insert(_carry.end(), data, data + take);
+                data += take;
+                size -= take;
+                if (_carry.size() < frameBytes)
+                {
+                    return;
+                }
+                convert(_carry.data(), 1, out);
+                _carry.clear();
+            }
+            const std::size_t frames = size / frameBytes;
+            convert(data, frames, out);
+            _carry.assign(data + frames * frameBytes, data + size);
+        }
+
+        void PcmConverter::convert(const std::uint8_t *data, std::size_t frames, std::vector<std::uint8_t> &out)
+        {
+            const int inChannels = _input.channels;
+            const int outChannels = _output.channels;
+            const std::size_t inSampleBytes = _input.bytesPerSample();
+            const std::size_t outSampleBytes = _output.bytesPerSample();
+            DitherState *dither = _options.dither && _input.sampleFormat != SampleFormat::Int16 ? &_dither : nullptr;
+
+            const std::size_t block = std::min(frames, kBlockFrames);
+            _samples.resize(block * static_cast<std::size_t>(inChannels));
+            _mixed.resize(block * static_cast<std::size_t>(std::max(inChannels, outChannels)));
+            _planes.resize(_input.planar ? static_cast<std::size_t>(inChannels) : 0);
+
+            // Chunks split mid-buffer may start at any byte.
+            if (reinterpret_cast<std::uintptr_t>(data) % inSampleBytes != 0)
+            {
+                const std::size_t bytes = frames * _input.bytesPerFrame();
+                _staging.resize((bytes + sizeof(float) - 1) / sizeof(float));
+                std::memcpy(_staging.data(), data, bytes);
+                data = reinterpret_cast<const std::uint8_t *>(_staging.data());
+            }
+
+            auto decode = [this](const std::uint8_t *src, float *dst, std::size_t count)
+            {
+                switch (_input.sampleFormat)
+                {
+                case SampleFormat::Int16:
+                    int16ToFloat(reinterpret_cast<const std::int16_t *>(src), dst, count);
+                    break;
+                case SampleFormat::Int32:
+                    int32ToFloat(reinterpret_cast<const std::int32_t *>(src), dst, count);
+                    break;
+                default:
+                    std::memcpy(dst, src, count * sizeof(float));
+                    break;
+                }
+            };
+
+            for (std::size_t done = 0; done < frames;)
+            {
+                const std::size_t n = std::min(block, frames - done);
+                if (_input.planar)
+                {
+                    for (int c = 0; c < inChannels; ++c)
+                    {
+                        _planes[c] = _mixed.data() + static_cast<std::size_t>(c) * n;
+                        decode(data + (static_cast<std::size_t>(c) * frames + done) * inSampleBytes, _planes[c], n);
+                    }
+                    interleave(_planes.data(), inChannels, n, _samples.data());
+                }
+                else
+                {
+                    decode(data + done * _input.bytesPerFrame(), _samples.data(), n * inChannels);
+                }
+
+                const float *mixed = _samples.data();
+                if (outChannels == 1 && inChannels > 1)
+                {
+                    downmixToMono(_samples.data(), inChannels, n, _mixed.data());
+                    mixed = _mixed.data();
+                }
+                else if (outChannels != inChannels)
+                {
+                    for (std::size_t f = 0; f < n; ++f)
+                    {
+                        for (int c = 0; c < outChannels; ++c)
+                        {
+                            _mixed[f * outChannels + c] = _samples[f * inChannels + c % inChannels];
+                        }
+                    }
+                    mixed = _mixed.data();
+                }
+
+                const std::size_t count = n * static_cast<std::size_t>(outChannels);
+                const std::size_t offset = out.size();
+                out.resize(offset + count * outSampleBytes);
+                std::uint8_t *dst = out.data() + offset;
+                switch (_output.sampleFormat)
+                {
+                case SampleFormat::Int16:
+                    floatToInt16(mixed, reinterpret_cast<std::int16_t *>(dst), count, dither);
+                    break;
+                case SampleFormat::Int32:
+                    floatToInt32(mixed, reinterpret_cast<std::int32_t *>(dst), count);
+                    break;
+                default:
+                    std::memcpy(dst, mixed, count * sizeof(float));
+                    break;
+                }
+                done += n;
+            }
+        }
+    }
+}
@@ -0,0 +1,365 @@
+#include <deepgrampp/audio/resampler.hpp>
+#include <deepgrampp/audio/pcm.hpp>
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <numeric>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#define DEEPGRAMPP_RESAMPLER_SSE2 1
+#include <immintrin.h>
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define DEEPGRAMPP_RESAMPLER_AVX2 1
+#endif
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#define DEEPGRAMPP_RESAMPLER_NEON 1
+#include <arm_neon.h>
+#endif
+
+namespace deepgram
+{
+    namespace audio
+    {
+        namespace
+        {
+            constexpr double kPi = 3.14159265358979323846;
+            // Kaiser window shape for about 80 dB of stopband attenuation.
+            constexpr double kKaiserBeta = 7.857;
+
+            float scalarDot(const float *a, const float *b, std::size_t n)
+            {
+                float sum = 0.0f;
+                for (std::size_t i = 0; i < n; ++i)
+                {
+                    sum += a[i] * b[i];
+                }
+                return sum;
+            }
+
+#if defined(DEEPGRAMPP_RESAMPLER_SSE2)
+            float sse2Dot(const float *a, const float *b, std::size_t n)
+            {
+                __m128 acc0 = _mm_setzero_ps();
+                __m128 acc1 = _mm_setzero_ps();
+                std::size_t i = 0;
+                for (; i + 8 <= n; i += 8)
+                {
+                    acc0 = _mm_add_ps(acc0, _mm_mul_ps(_mm_loadu_ps(a + i), _mm_loadu_ps(b + i)));
+                    acc1 = _mm_add_ps(acc1, _mm_mul_ps(_mm_loadu_ps(a + i + 4), _mm_loadu_ps(b + i + 4)));
+                }
+                __m128 acc = _mm_add_ps(acc0, acc1);
+                acc = _mm_add_ps(acc, _mm_movehl_ps(acc, acc));
+                acc = _mm_add_ss(acc, _mm_shuffle_ps(acc, acc, 1));
+                return _mm_cvtss_f32(acc) + scalarDot(a + i, b + i, n - i);
+            }
+#endif
+
+#if defined(DEEPGRAMPP_RESAMPLER_AVX2)
+            __attribute__((target("avx2,fma"))) float avx2Dot(const float *a, const float *b, std::size_t n)
+            {
+                __m256 acc0 = _mm256_setzero_ps();
+                __m256 acc1 = _mm256_setzero_ps();
+                std::size_t i = 0;
+                for (; i + 16 <= n; i += 16)
+                {
+                    acc0 = _mm256_fmadd_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i), acc0);
+                    acc1 = _mm256_fmadd_ps(_mm256_loadu_ps(a + i + 8), _mm256_loadu_ps(b + i + 8), acc1);
+                }
+                for (; i + 8 <= n; i += 8)
+                {
+                    acc0 = _mm256_fmadd_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i), acc0);
+                }
+                const __m256 acc = _mm256_add_ps(acc0, acc1);
+                __m128 sum = _mm_add_ps(_mm256_castps256_ps128(acc), _mm256_extractf128_ps(acc, 1));
+                sum = _mm_add_ps(sum, _mm_movehl_ps(sum, sum));
+                sum = _mm_add_ss(sum, _mm_shuffle_ps(sum, sum, 1));
+                return _mm_cvtss_f32(sum) + scalarDot(a + i, b + i, n - i);
+            }
+#endif
+
+#if defined(DEEPGRAMPP_RESAMPLER_NEON)
+            float neonDot(const float *a, const float *b, std::size_t n)
+            {
+                float32x4_t acc0 = vdupq_n_f32(0.0f);
+                float32x4_t acc1 = vdupq_n_f32(0.0f);
+                std::size_t i = 0;
+                for (; i + 8 <= n; i += 8)
+                {
+                    acc0 = vfmaq_f32(acc0, vld1q_f32(a + i), vld1q_f32(b + i));
+                    acc1 = vfmaq_f32(acc1, vld1q_f32(a + i + 4), vld1q_f32(b + i + 4));
+                }
+                return vaddvq_f32(vaddq_f32(acc0, acc1)) + scalarDot(a + i, b + i, n - i);
+            }
+#endif
+
+            using DotKernel = float (*)(const float *, const float *, std::size_t);
+
+            DotKernel selectDot()
+            {
+#if defined(DEEPGRAMPP_RESAMPLER_AVX2)
+                if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"))
+                {
+                    return avx2Dot;
+                }
+#endif
+#if defined(DEEPGRAMPP_RESAMPLER_SSE2)
+                return sse2Dot;
+#elif defined(DEEPGRAMPP_RESAMPLER_NEON)
+                return neonDot;
+#else
+                return scalarDot;
+#endif
+            }
+
+            DotKernel dotKernel()
+            {
+                static const DotKernel selected = selectDot();
+                return selected;
+            }
+
+            double besselI0(double x)
+            {
+                double sum = 1.0;
+                double term = 1.0;
+                for (int k = 1; k < 50; ++k)
+                {
+                    term *= (x / (2.0 * k)) * (x / (2.0 * k));
+                    sum += term;
+                    if (term < sum * 1e-12)
+                    {
+                        break;
+                    }
+                }
+                return sum;
+            }
+        }
+
+        Resampler::Resampler(ResamplerOptions options) : _options(options) {}
+
+        AudioFormat Resampler::configure(const AudioFormat &input, const AudioFormat &wire)
+        {
+            _input = input;
+            _output = input;
+            _passThrough = true;
+            _taps = 0;
+            const int outputRate = _options.outputRate > 0 ? _options.outputRate : wire.sampleRate;
+            if (input.sampleRate <= 0 || outputRate <= 0 || input.sampleRate == outputRate)
+            {
+                return _output;
+            }
+            if (!input.linear() || input.planar || input.channels <= 0)
+            {
+                spdlog::warn("Resampler needs interleaved PCM, passing {} through", toString(input));
+                return _output;
+            }
+            _output.sampleRate = outputRate;
+            _passThrough = false;
+            design();
+            reset();
+            return _output;
+        }
+
+        void Resampler::design()
+        {
+            const std::uint64_t inRate = static_cast<std::uint64_t>(_input.sampleRate);
+            const std::uint64_t outRate = static_cast<std::uint64_t>(_output.sampleRate);
+            const std::uint64_t steps = outRate / std::gcd(inRate, outRate);
+            _phases = static_cast<std::size_t>(std::min<std::uint64_t>(steps, kMaxPhases));
+
+            // Cutoff in cycles per input sample, below the lower Nyquist rate.
+            const double cutoff = 0.5 * std::clamp(_options.cutoff, 0.1, 1.0) *
+                                  static_cast<double>(std::min(inRate, outRate)) / static_cast<double>(inRate);
+            const int zeroCrossings = std::max(_options.zeroCrossings, 2);
+            // A multiple of 8 so the dot product needs no scalar tail.
+            _taps = (static_cast<std::size_t>(std::ceil(zeroCrossings / (2.0 * cutoff)) * 2) + 7) & ~std::size_t(7);
+            const double half = static_cast<double>(_taps / 2);
+
+            _coefficients.assign(_phases * _taps, 0.0f);
+            const double window = besselI0(kKaiserBeta);
+            for (std::size_t p = 0; p < _phases; ++p)
+            {
+                const double phase = static_cast<double>(p) / static_cast<double>(_phases);
+                float *row = &_coefficients[p * _taps];
+                double sum = 0.0;
+                for (std::size_t k = 0; k < _taps; ++k)
+                {
+                    // Distance from the output instant back to tap k's input frame.
+                    const double t = phase + half - 1.0 - static_cast<double>(k);
+                    const double x = 2.0 * cutoff * t;
+                    const double sinc = x == 0.0 ? 1.0 : std::sin(kPi * x) / (kPi * x);
+                    const double r = t / half;
+                    const double w = r * r < 1.0 ? besselI0(kKaiserBeta * std::sqrt(1.0 - r * r)) / window : 0.0;
+                    row[k] = static_cast<float>(sinc * w);
+                    sum += sinc * w;
+                }
+                // Unity gain at DC for every phase.
+                for (std::size_t k = 0; k < _taps; ++k)
+                {
+                    row[k] = static_cast<float>(row[k] / sum);
+                }
+            }
+        }
+
+        void Resampler::reset()
+        {
+            const std::size_t channels = static_cast<std::size_t>(_input.channels);
+            _history.resize(channels);
+            _planes.resize(channels);
+            // Leading silence, so the first output can be centered on frame 0.
+            for (auto &plane : _history)
+            {
+                plane.assign(_taps / 2 - 1, 0.0f);
+            }
+            _position = _taps / 2 - 1;
+            _fraction = 0;
+            _framesIn = 0;
+            _framesOut = 0;
+            _carry.clear();
+        }
+
+        void Resampler::process(const std::uint8_t *data, std::size_t size, std::vector<std::uint8_t> &out)
+        {
+            if (_passThrough)
+            {
+                out.insert(out.end(), data, data + size);
+                return;
+            }
+            const std::size_t frameBytes = _input.bytesPerFrame();
+            if (!_carry.empty())
+            {
+                const std::size_t take = std::min(frameBytes - _carry.size(), size);
+                _carry.insert(_carry.end(), data, data + take);
+                data += take;
+                size -= take;
+                if (_carry.size() < frameBytes)
+                {
+                    return;
+                }
+                append(_carry.data(), 1);
+                _carry.clear();
+            }
+            const std::size_t frames = size / frameBytes;
+            append(data, frames);
+            _carry.assign(data + frames * frameBytes, data + size);
+            produce(std::numeric_limits<std::uint64_t>::max(), out);
+        }
+
+        void Resampler::flush(std::vector<std::uint8_t> &out)
+        {
+            if (_passThrough)
+            {
+                return;
+            }
+            // Silence past the end lets the last outputs see their full kernel.
+            for (auto &plane : _history)
+            {
+                plane.resize(plane.size() + _taps / 2, 0.0f);
+            }
+            const std::uint64_t inRate = static_cast<std::uint64_t>(_input.sampleRate);
+            const std::uint64_t outRate = static_cast<std::uint64_t>(_output.sampleRate);
+            produce((_framesIn * outRate + inRate - 1) / inRate, out);
+            reset();
+        }
+
+        void Resampler::append(const std::uint8_t *data, std::size_t frames)
+        {
+            if (frames == 0)
+            {
+                return;
+            }
+            const std::size_t channels = _history.size();
+            const std::size_t count = frames * channels;
+            _samples.resize(count);
+            if (_input.sampleFormat == SampleFormat::Float32)
+            {
+                std::memcpy(_samples.data(), data, count * sizeof(float));
+            }
+            else
+            {
+                // Chunks may start at any byte; decode from an aligned copy.
+                const std::size_t bytes = count * _input.bytesPerSample();
+                _staging.resize((bytes + sizeof(float) - 1) / sizeof(float));
+                std::memcpy(_staging.data(), data, bytes);
+                if (_input.sampleFormat == SampleFormat::Int16)
+                {
+                    int16ToFloat(reinterpret_cast<const std::int16_t *>(_staging.data()), _samples.data(), count);
+                }
+                else
+                {
+                    int32ToFloat(reinterpret_cast<const std::int32_t *>(_staging.data()), _samples.data(), count);
+                }
+            }
+
+            for (std::size_t c = 0; c < channels; ++c)
+            {
+                _history[c].resize(_history[c].size() + frames);
+                _planes[c] = _history[c].data() + _history[c].size() - frames;
+            }
+            deinterleave(_samples.data(), static_cast<int>(channels), frames, _planes.data());
+            _framesIn += frames;
+        }
+
+        void Resampler::produce(std::uint64_t limit, std::vector<std::uint8_t> &out)
+        {
+            const std::size_t channels = _history.size();
+            const std::size_t half = _taps / 2;
+            const std::size_t available = _history[0].size();
+            const std::uint64_t inRate = static_cast<std::uint64_t>(_input.sampleRate);
+            const std::uint64_t outRate = static_cast<std::uint64_t>(_output.sampleRate);
+            const DotKernel dot = dotKernel();
+
+            _produced.clear();
+            while (_framesOut < limit && _position + half < available)
+            {
+                const std::size_t phase = static_cast<std::size_t>(_fraction * _phases / outRate);
+                const float *row = &_coefficients[phase * _taps];
+                const std::size_t first = _position + 1 - half;
+                for (std::size_t c = 0; c < channels; ++c)
+                {
+                    _produced.push_back(dot(row, _history[c].data() + first, _taps));
+                }
+                ++_framesOut;
+                _fraction += inRate;
+                _position += static_cast<std::size_t>(_fraction / outRate);
+                _fraction %= outRate;
+            }
+
+            // Keep only the frames the next output's kernel still reaches.
+            const std::size_t drop = std::min(_position + 1 - half, available);
+            if (drop > 0)
+            {
+                for (auto &plane : _history)
+                {
+                    plane.erase(plane.begin(), plane.begin() + static_cast<std::ptrdiff_t>(drop));
+                }
+                _position -= drop;
+            }
+
+            const std::size_t count = _produced.size();
+            if (count == 0)
+            {
+                return;
+            }
+            const std::size_t offset = out.size();
+            out.resize(offset + count * _output.bytesPerSample());
+            std::uint8_t *dst = out.data() + offset;
+            switch (_output.sampleFormat)
+            {
+            case SampleFormat::Int16:
+                floatToInt16(_produced.data(), reinterpret_cast<std::int16_t *>(dst), count);
+                break;
+            case SampleFormat::Int32:
+                floatToInt32(_produced.data(), reinterpret_cast<std::int32_t *>(dst), count);
+                break;
+            default:
+                std::memcpy(dst, _produced.data(), count * sizeof(float));
+                break;
+            }
+        }
+    }
+}
@@ -0,0 +1,288 @@
+#include <deepgrampp/audio/vad.hpp>
+#include <deepgrampp/audio/g711.hpp>
+#include <deepgrampp/audio/pcm.hpp>
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace deepgram
+{
+    namespace audio
+    {
+        namespace
+        {
+            constexpr double kMinNoiseFloorDb = -120.0;
+
+            // How fast the noise floor follows the level: at once halfway down,
+            // within about a second up through non-speech, and only slowly
+            // through speech, so steady noise that starts out looking like
+            // speech is eventually taken for noise.
+            constexpr double kFloorFall = 0.5;
+            constexpr double kFloorRise = 0.05;
+            constexpr double kFloorRiseInSpeech = 0.01;
+
+            std::size_t blocksIn(std::chrono::milliseconds duration, std::chrono::milliseconds block)
+            {
+                return duration.count() > 0 ? static_cast<std::size_t>((duration.count() + block.count() - 1) / block.count()) : 0;
+            }
+        }
+
+        VoiceActivityGate::VoiceActivityGate(VoiceGateOptions options) : _options(options) {}
+
+        AudioFormat VoiceActivityGate::configure(const AudioFormat &input, const AudioFormat &wire)
+        {
+            (void)wire;
+            _format = input;
+            _passThrough = true;
+            _open = false;
+            _hangoverLeft = 0;
+            _noiseFloorDb = _options.thresholdDb;
+            _inputFrames = 0;
+            _sentFrames = 0;
+            _suppressedFrames.store(0);
+            _pending.clear();
+            _preRollHead = 0;
+            _preRollCount = 0;
+            {
+                std::lock_guard<std::mutex> lk(_segmentsMutex);
+                _segments.clear();
+                _sampleRate = input.sampleRate;
+            }
+
+            const bool analyzable = input.linear() || input.sampleFormat == SampleFormat::Mulaw || input.sampleFormat == SampleFormat::Alaw;
+            if (!analyzable || input.planar || input.channels <= 0 || input.sampleRate <= 0 || _options.frame.count() <= 0)
+            {
+                spdlog::warn("VoiceActivityGate can't analyze {}, passing it through", toString(input));
+                _gated.store(false);
+                return input;
+            }
+
+            _blockFrames = std::max<std::size_t>(2, static_cast<std::size_t>(input.sampleRate) * _options.frame.count() / 1000);
+            _blockBytes = _blockFrames * input.bytesPerFrame();
+            _preRollBlocks = blocksIn(_options.preRoll, _options.frame);
+            _hangoverBlocks = blocksIn(_options.hangover, _options.frame);
+            _preRoll.resize(_preRollBlocks * _blockBytes);
+            _pending.reserve(_blockBytes);
+            const std::size_t samples = _blockFrames * static_cast<std::size_t>(input.channels);
+            _samples.resize(samples);
+            _pcm16.resize(input.sampleFormat == SampleFormat::Int32 || input.sampleFormat == SampleFormat::Float32 ? 0 : samples);
+            _pcm32.resize(input.sampleFormat == SampleFormat::Int32 ? samples : 0);
+            _passThrough = false;
+            _gated.store(true);
+            return input;
+        }
+
+        void VoiceActivityGate::process(const std::uint8_t *data, std::size_t size, std::vector<std::uint8_t> &out)
+        {
+            if (_passThrough)
+            {
+                out.insert(out.end(), data, data + size);
+                return;
+            }
+            while (size > 0)
+            {
+                if (!_pending.empty() || size < _blockBytes)
+                {
+                    const std::size_t take = std::min(_blockBytes - _pending.size(), size);
+                    _pending.insert(_pending.end(), data, data + take);
+                    data += take;
+                    size -= take;
+                    if (_pending.size() == _blockBytes)
+                    {
+                        handleBlock(_pending.data(), out);
+                        _pending.clear();
+                    }
+                }
+                else
+                {
+                    handleBlock(data, out);
+                    data += _blockBytes;
+                    size -= _blockBytes;
+                }
+            }
+        }
+
+        void VoiceActivityGate::flush(std::vector<std::uint8_t> &out)
+        {
+            if (_passThrough || _pending.empty())
+            {
+                _pending.clear();
+                return;
+            }
+            const std::size_t frames = _pending.size() / _format.bytesPerFrame();
+            _inputFrames += frames;
+            if (_open)
+            {
+                emit(_pending.data(), frames * _format.bytesPerFrame(), out);
+            }
+            else
+            {
+                // The pre-roll must lead straight into the block that opens
+                // the gate, and this tail now sits between them.
+                _suppressedFrames.fetch_add(frames + _preRollCount * _blockFrames, std::memory_order_relaxed);
+                _preRollCount = 0;
+            }
+            _pending.clear();
+        }
+
+        bool VoiceActivityGate::gated() const
+        {
+            return _gated.load();
+        }
+
+        double VoiceActivityGate::suppressedSeconds() const
+        {
+            std::lock_guard<std::mutex> lk(_segmentsMutex);
+            return _sampleRate > 0 ? static_cast<double>(_suppressedFrames.load()) / _sampleRate : 0.0;
+        }
+
+        double VoiceActivityGate::toStreamTime(double serverSeconds) const
+        {
+            std::lock_guard<std::mutex> lk(_segmentsMutex);
+            if (_segments.empty() || _sampleRate <= 0)
+            {
+                return serverSeconds;
+            }
+            const double serverFrame = serverSeconds * _sampleRate;
+            // The last gap that ends at or before this time decides the offset.
+            auto it = std::upper_bound(_segments.begin(), _segments.end(), serverFrame, [](double frame, const Segment &segment)
+                                       { return frame < static_cast<double>(segment.serverFrame); });
+            if (it == _segments.begin())
+            {
+                return serverSeconds;
+            }
+            --it;
+            return serverSeconds + static_cast<double>(it->streamFrame - it->serverFrame) / _sampleRate;
+        }
+
+        void VoiceActivityGate::handleBlock(const std::uint8_t *block, std::vector<std::uint8_t> &out)
+        {
+            const bool speech = isSpeech(block);
+            if (speech)
+            {
+                _hangoverLeft = _hangoverBlocks;
+            }
+
+            if (speech && !_open)
+            {
+                _open = true;
+                _gated.store(false);
+                const std::uint64_t streamFrame = _inputFrames - _preRollCount * _blockFrames;
+                {
+                    std::lock_guard<std::mutex> lk(_segmentsMutex);
+                    const std::uint64_t offset = _segments.empty() ? 0 : _segments.back().streamFrame - _segments.back().serverFrame;
+                    if (streamFrame - _sentFrames != offset)
+                    {
+                        _segments.push_back({_sentFrames, streamFrame});
+                    }
+                }
+                const std::size_t oldest = (_preRollHead + _preRollBlocks - _preRollCount) % std::max<std::size_t>(_preRollBlocks, 1);
+                for (std::size_t i = 0; i < _preRollCount; ++i)
+                {
+                    emit(_preRoll.data() + ((oldest + i) % _preRollBlocks) * _blockBytes, _blockBytes, out);
+                }
+                _preRollCount = 0;
+            }
+            else if (!speech && _open)
+            {
+                if (_hangoverLeft > 0)
+                {
+                    --_hangoverLeft;
+                }
+                else
+                {
+                    _open = false;
+                    _gated.store(true);
+                }
+            }
+
+            _inputFrames += _blockFrames;
+            if (_open)
+            {
+                emit(block, _blockBytes, out);
+                return;
+            }
+
+            // Held back: the block becomes pre-roll, pushing out the oldest.
+            if (_preRollBlocks == 0)
+            {
+                _suppressedFrames.fetch_add(_blockFrames, std::memory_order_relaxed);
+                return;
+            }
+            if (_preRollCount == _preRollBlocks)
+            {
+                _suppressedFrames.fetch_add(_blockFrames, std::memory_order_relaxed);
+            }
+            else
+            {
+                ++_preRollCount;
+            }
+            std::memcpy(_preRoll.data() + _preRollHead * _blockBytes, block, _blockBytes);
+            _preRollHead = (_preRollHead + 1) % _preRollBlocks;
+        }
+
+        bool VoiceActivityGate::isSpeech(const std::uint8_t *block)
+        {
+            const std::size_t count = _samples.size();
+            switch (_format.sampleFormat)
+            {
+            case SampleFormat::Int16:
+                std::memcpy(_pcm16.data(), block, count * sizeof(std::int16_t));
+                int16ToFloat(_pcm16.data(), _samples.data(), count);
+                break;
+            case SampleFormat::Int32:
+                std::memcpy(_pcm32.data(), block, count * sizeof(std::int32_t));
+                int32ToFloat(_pcm32.data(), _samples.data(), count);
+                break;
+            case SampleFormat::Float32:
+                std::memcpy(_samples.data(), block, count * sizeof(float));
+                break;
+            case SampleFormat::Mulaw:
+                mulawDecode(block, _pcm16.data(), count);
+                int16ToFloat(_pcm16.data(), _samples.data(), count);
+                break;
+            default:
+                alawDecode(block, _pcm16.data(), count);
+                int16ToFloat(_pcm16.data(), _samples.data(), count);
+                break;
+            }
+
+            double energy = 0.0;
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                energy += static_cast<double>(_samples[i]) * _samples[i];
+            }
+            const double levelDb = 10.0 * std::log10(energy / static_cast<double>(count) + 1e-12);
+
+            // Zero crossings of the first channel, per sample.
+            const std::size_t stride = static_cast<std::size_t>(_format.channels);
+            std::size_t crossings = 0;
+            for (std::size_t i = 1; i < _blockFrames; ++i)
+            {
+                crossings += (_samples[i * stride] >= 0.0f) != (_samples[(i - 1) * stride] >= 0.0f);
+            }
+            const double zeroCrossingRate = static_cast<double>(crossings) / static_cast<double>(_blockFrames - 1);
+
+            const bool speech = levelDb > _options.thresholdDb &&
+                                (levelDb > _noiseFloorDb + _options.snrDb ||
+                                 (levelDb > _noiseFloorDb + _options.snrDb / 2 && zeroCrossingRate >= _options.zeroCrossingRate));
+
+            double rate = speech ? kFloorRiseInSpeech : kFloorRise;
+            if (levelDb < _noiseFloorDb)
+            {
+                rate = kFloorFall;
+            }
+            _noiseFloorDb = std::max(kMinNoiseFloorDb, _noiseFloorDb + rate * (levelDb - _noiseFloorDb));
+            return speech;
+        }
+
+        void VoiceActivityGate::emit(const std::uint8_t *data, std::size_t size, std::vector<std::uint8_t> &out)
+        {
+            out.insert(out.end(), data, data + size);
+            _sentFrames += size / _format.bytesPerFrame();
+        }
+    }
+}
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <deepgrampp_lib_export.h>
+
+#include <cstddef>
+#include <string>
+
+namespace deepgram
+{
+    namespace audio
+    {
+        enum class SampleFormat
+        {
+            Int16,   // linear16
+            Int32,   // linear32
+            Float32, // IEEE float in [-1, 1), e.g. from a capture API
+            Mulaw,   // G.711 mu-law, one byte per sample
+            Alaw,    // G.711 A-law, one byte per sample
+            Encoded  // compressed or containerized; not sample-addressable
+        };
+
+        /**
+         * Layout of a PCM stream. Interleaved unless `planar`, in which case a
+         * chunk holds all of channel 0's samples, then all of channel 1's, ...
+         */
+        struct AudioFormat
+        {
+            SampleFormat sampleFormat = SampleFormat::Int16;
+            int sampleRate = 16000;
+            int channels = 1;
+            bool planar = false;
+
+            /**
+             * Bytes per sample of one channel, or 0 for SampleFormat::Encoded.
+             */
+            std::size_t bytesPerSample() const;
+
+            /**
+             * Bytes per sample frame (one sample of every channel), or 0.
+             */
+            std::size_t bytesPerFrame() const;
+
+            /**
+             * Byte rate at real time, or 0 if it can't be known.
+             */
+            std::size_t bytesPerSecond() const;
+
+            /**
+             * True for linear PCM (Int16, Int32, Float32), the formats the
+             * converter and resampler work on.
+             */
+            bool linear() const;
+
+            bool operator==(const AudioFormat &other) const;
+            bool operator!=(const AudioFormat &other) const { return !(*this == other); }
+        };
+
+        /**
+         * The format Deepgram expects for an `encoding` query parameter
+         * (linear16, linear32, mulaw, alaw, ...), as sent over the wire.
+         */
+        DEEPGRAMPP_EXPORT AudioFormat wireFormat(const std::string &encoding, int sampleRate, int channels);
+
+        DEEPGRAMPP_EXPORT std::string toString(const AudioFormat &format);
+    }
+}
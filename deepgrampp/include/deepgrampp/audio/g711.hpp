@@ -0,0 +1,48 @@
+#pragma once
+
+#include <deepgrampp_lib_export.h>
+
+#include "stage.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace deepgram
+{
+    namespace audio
+    {
+        /**
+         * G.711 companding (ITU-T G.711, as in the reference g711.c), the
+         * `mulaw`/`alaw` encodings of telephony audio: one byte per sample,
+         * half the size of linear16.
+         *
+         * Encoding is vectorized (SSE2 on x86, NEON on ARM64, scalar
+         * elsewhere); every path gives the same bytes. Decoding is a 256-entry
+         * table lookup.
+         */
+        DEEPGRAMPP_EXPORT void mulawEncode(const std::int16_t *in, std::uint8_t *out, std::size_t count);
+        DEEPGRAMPP_EXPORT void mulawDecode(const std::uint8_t *in, std::int16_t *out, std::size_t count);
+        DEEPGRAMPP_EXPORT void alawEncode(const std::int16_t *in, std::uint8_t *out, std::size_t count);
+        DEEPGRAMPP_EXPORT void alawDecode(const std::uint8_t *in, std::int16_t *out, std::size_t count);
+
+        /**
+         * Compresses int16 audio to the connection's `mulaw` or `alaw`
+         * encoding. Put it last in the pipeline, after any PcmConverter or
+         * Resampler; it passes audio through unless the wire is G.711.
+         */
+        class DEEPGRAMPP_EXPORT G711Encoder : public IAudioStage
+        {
+        public:
+            AudioFormat configure(const AudioFormat &input, const AudioFormat &wire) override;
+            void process(const std::uint8_t *data, std::size_t size, std::vector<std::uint8_t> &out) override;
+
+        private:
+            AudioFormat _output;
+            bool _passThrough = true;
+            bool _carrying = false;
+            std::uint8_t _carry = 0;
+            std::vector<std::int16_t> _staging;
+        };
+    }
+}
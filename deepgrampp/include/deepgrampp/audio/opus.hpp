@@ -0,0 +1,127 @@
+#pragma once
+
+#include <deepgrampp_lib_export.h>
+
+#include "stage.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// The Opus stage needs libopus, so it only exists in builds configured with
+// -DDEEPGRAMPP_WITH_OPUS=ON.
+#if defined(DEEPGRAMPP_WITH_OPUS)
+
+struct OpusEncoder; // libopus
+
+namespace deepgram
+{
+    namespace audio
+    {
+        enum class OpusContainer
+        {
+            Ogg, // Ogg pages (RFC 7845), encoding=ogg-opus
+            Raw  // bare Opus packets, encoding=opus
+        };
+
+        struct OpusEncoderOptions
+        {
+            /**
+             * Target bitrate in bits per second, for all channels. 16-24 kbps
+             * is transparent for speech recognition at 16 kHz mono.
+             */
+            int bitrate = 24000;
+
+            /**
+             * Audio per Opus packet: 10, 20, 40 or 60 ms. Longer frames cost
+             * less overhead but add latency.
+             */
+            std::chrono::milliseconds frameDuration{20};
+
+            OpusContainer container = OpusContainer::Ogg;
+
+            /**
+             * Encoder complexity, 0 (cheapest) to 10 (best quality per bit).
+             */
+            int complexity = 5;
+        };
+
+        /**
+         * Compresses int16 or float32 PCM (interleaved, 1 or 2 channels, at
+         * 8, 12, 16, 24 or 48 kHz) with libopus, tuned for voice: a few
+         * percent of the linear16 byte rate at 16 kHz.
+         *
+         * In the Ogg container the first output carries the OpusHead and
+         * OpusTags pages, then each process() call emits one page holding the
+         * packets it completed; a page costs 28 bytes or so, so with 20 ms
+         * chunks longer frames pay for themselves. Raw packets can't be told apart in a byte
+         * stream, so Raw output prefixes each packet with its length as a
+         * 16-bit little-endian integer; ListenWebsocketClient strips those and
+         * sends each packet as one message.
+         *
+         * Give it to ListenWebsocketClient::setOpusEncoder(), which also sets
+         * the connection's query parameters to match.
+         */
+        class DEEPGRAMPP_EXPORT OpusEncoderStage : public IAudioStage
+        {
+        public:
+            explicit OpusEncoderStage(OpusEncoderOptions options = {});
+            ~OpusEncoderStage() override;
+
+            OpusEncoderStage(const OpusEncoderStage &) = delete;
+            OpusEncoderStage &operator=(const OpusEncoderStage &) = delete;
+
+            AudioFormat configure(const AudioFormat &input, const AudioFormat &wire) override;
+            void process(const std::uint8_t *data, std::size_t size, std::vector<std::uint8_t> &out) override;
+
+            /**
+             * Pads the partial frame with silence and encodes it. The stream
+             * carries on afterwards: Finalize doesn't end the Ogg stream.
+             */
+            void flush(std::vector<std::uint8_t> &out) override;
+
+            const OpusEncoderOptions &options() const { return _options; }
+
+            /**
+             * The `encoding` query parameter for this stage's output:
+             * "ogg-opus" or "opus".
+             */
+            const char *encoding() const;
+
+            /**
+             * Whether Opus can encode at `sampleRate` as is.
+             */
+            static bool supportsRate(int sampleRate);
+
+        private:
+            void encodeFrame(const std::uint8_t *frame);
+            void writePackets(std::vector<std::uint8_t> &out);
+            void writePage(std::uint8_t headerType, const std::uint8_t *data, const std::vector<std::size_t> &packets,
+                           std::int64_t granule, std::vector<std::uint8_t> &out);
+            void writeHeaders(std::vector<std::uint8_t> &out);
+
+            OpusEncoderOptions _options;
+            AudioFormat _input;
+            bool _passThrough = true;
+            ::OpusEncoder *_encoder = nullptr;
+            int _frameSamples = 0; // per channel
+            std::size_t _frameBytes = 0;
+            int _preSkip = 0;      // at 48 kHz
+
+            std::vector<std::uint8_t> _pending;
+            std::vector<std::uint8_t> _packets;   // packets completed in this call
+            std::vector<std::size_t> _packetSizes;
+            std::vector<std::int16_t> _pcm16;
+            std::vector<float> _pcmFloat;
+
+            // Ogg stream state.
+            bool _headersWritten = false;
+            std::uint32_t _serial = 0;
+            std::uint32_t _pageSequence = 0;
+            std::int64_t _granule = 0; // 48 kHz samples encoded
+        };
+    }
+}
+
+#endif
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <deepgrampp_lib_export.h>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+
+namespace deepgram
+{
+    namespace audio
+    {
+        /**
+         * How fast streamAudioPaced() feeds recorded audio to the server.
+         */
+        struct PacingOptions
+        {
+            /**
+             * Playback rate relative to real time: 1 sends audio as fast as it
+             * would be captured live, 2 twice as fast, and so on. 0 (or any value
+             * <= 0) disables pacing and sends as fast as the transport accepts.
+             */
+            double speed = 1.0;
+
+            /**
+             * Audio carried by each WebSocket frame. 20-100 ms is typical for
+             * live capture.
+             */
+            std::chrono::milliseconds frameDuration{20};
+        };
+
+        /**
+         * Size in bytes of one sample frame (one sample for each channel) of a
+         * raw, fixed-rate encoding (linear16, linear32, mulaw, alaw), or 0 for
+         * encodings whose byte rate can't be derived from the sample rate
+         * (compressed or containerized audio).
+         */
+        DEEPGRAMPP_EXPORT std::size_t bytesPerSampleFrame(const std::string &encoding, int channels);
+
+        /**
+         * Splits `size` bytes into frames of `options.frameDuration` worth of
+         * audio and hands them to `sendFrame` on a real-time schedule. Each
+         * frame is due when the audio before it would have finished playing
+         * (start + bytesSent / bytesPerSecond / speed on the monotonic clock)
+         * and is waited for with sleep_until, so late wake-ups or slow sends
+         * never accumulate into drift; a sender that fell behind catches up
+         * without sleeping.
+         *
+         * @param bytesPerSecond Byte rate of the audio at 1x, e.g.
+         *        sampleRate * bytesPerSampleFrame(encoding, channels).
+         * @param sendFrame Returns false to abort (e.g. the socket closed).
+         * @return false if `bytesPerSecond` is 0 or `sendFrame` failed.
+         */
+        DEEPGRAMPP_EXPORT bool streamPaced(const std::uint8_t *data, std::size_t size,
+                                           std::size_t bytesPerSecond, std::size_t bytesPerSampleFrame,
+                                           const PacingOptions &options,
+                                           const std::function<bool(const std::uint8_t *, std::size_t)> &sendFrame);
+    }
+}
@@ -0,0 +1,105 @@
+#pragma once
+
+#include <deepgrampp_lib_export.h>
+
+#include "stage.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace deepgram
+{
+    namespace audio
+    {
+        /**
+         * PCM sample conversion kernels. Each has SSE2, AVX2 and NEON versions,
+         * picked once per process by CPU detection, and a scalar fallback;
+         * all of them produce bit-identical output. Float samples are
+         * normalized to [-1, 1); pointers need no particular alignment.
+         */
+
+        /**
+         * Per-stream state of the triangular (TPDF) dither applied by
+         * floatToInt16(): eight independent xorshift32 generators, one per
+         * vector lane, so the sequence doesn't depend on the kernel in use.
+         */
+        struct DitherState
+        {
+            explicit DitherState(std::uint32_t seed = 0x9E3779B9u);
+
+            std::uint32_t lanes[8];
+        };
+
+        DEEPGRAMPP_EXPORT void int16ToFloat(const std::int16_t *in, float *out, std::size_t count);
+        DEEPGRAMPP_EXPORT void int32ToFloat(const std::int32_t *in, float *out, std::size_t count);
+
+        /**
+         * Scales to 16 bits, adds +/-1 LSB of triangular dither when `dither`
+         * is set, rounds to nearest and clips to the int16 range (NaN maps to
+         * -32768).
+         */
+        DEEPGRAMPP_EXPORT void floatToInt16(const float *in, std::int16_t *out, std::size_t count,
+                                            DitherState *dither = nullptr);
+
+        DEEPGRAMPP_EXPORT void floatToInt32(const float *in, std::int32_t *out, std::size_t count);
+
+        /**
+         * `planes[c]` holds `frames` samples of channel c.
+         */
+        DEEPGRAMPP_EXPORT void interleave(const float *const *planes, int channels, std::size_t frames, float *out);
+        DEEPGRAMPP_EXPORT void deinterleave(const float *in, int channels, std::size_t frames, float *const *planes);
+
+        /**
+         * Averages the channels of each interleaved frame.
+         */
+        DEEPGRAMPP_EXPORT void downmixToMono(const float *in, int channels, std::size_t frames, float *out);
+
+        /**
+         * Name of the kernel set in use: "avx2", "sse2", "neon" or "scalar".
+         */
+        DEEPGRAMPP_EXPORT const char *simdBackend();
+
+        struct PcmConverterOptions
+        {
+            /**
+             * Dither when reducing float or int32 input to int16.
+             */
+            bool dither = true;
+        };
+
+        /**
+         * Converts capture-format PCM (int16, int32 or float32; interleaved or
+         * planar) to the connection's sample format and channel count:
+         * channels are averaged down to mono, mono is duplicated up, and any
+         * other mismatch maps output channel c to input channel c modulo the
+         * input count. Sample rate is left alone.
+         * When the wire is not raw PCM (e.g. a later stage encodes it), the
+         * output is int16.
+         *
+         * Interleaved input may be split anywhere; planar input must arrive in
+         * whole frames, since each chunk is taken to be one block of planes.
+         */
+        class DEEPGRAMPP_EXPORT PcmConverter : public IAudioStage
+        {
+        public:
+            explicit PcmConverter(PcmConverterOptions options = {});
+
+            AudioFormat configure(const AudioFormat &input, const AudioFormat &wire) override;
+            void process(const std::uint8_t *data, std::size_t size, std::vector<std::uint8_t> &out) override;
+
+        private:
+            void convert(const std::uint8_t *data, std::size_t frames, std::vector<std::uint8_t> &out);
+
+            PcmConverterOptions _options;
+            AudioFormat _input;
+            AudioFormat _output;
+            DitherState _dither;
+            std::vector<std::uint8_t> _carry;
+            std::vector<float> _samples;
+            std::vector<float> _mixed;
+            std::vector<float *> _planes;
+            std::vector<float> _staging;
+        };
+    }
+}
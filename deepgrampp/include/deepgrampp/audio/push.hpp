@@ -0,0 +1,33 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+
+namespace deepgram
+{
+    namespace audio
+    {
+        /**
+         * Configures the per-session buffer behind pushAudio(). Takes effect at
+         * the next connect().
+         */
+        struct PushOptions
+        {
+            /**
+             * Audio carried by each WebSocket frame the sender drains from the
+             * buffer. Only applies to raw encodings (linear16, linear32, mulaw,
+             * alaw); other encodings are sent in `fallbackFrameBytes` frames.
+             */
+            std::chrono::milliseconds frameDuration{20};
+
+            /**
+             * Buffer capacity in bytes, rounded up to a power of two. 0 sizes it
+             * for two seconds of audio (256 KiB for non-raw encodings). Audio
+             * pushed while the buffer is full is dropped.
+             */
+            std::size_t bufferBytes = 0;
+
+            std::size_t fallbackFrameBytes = 4096;
+        };
+    }
+}
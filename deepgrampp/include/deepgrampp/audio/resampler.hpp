@@ -0,0 +1,95 @@
+#pragma once
+
+#include <deepgrampp_lib_export.h>
+
+#include "stage.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace deepgram
+{
+    namespace audio
+    {
+        struct ResamplerOptions
+        {
+            /**
+             * Rate to convert to; 0 uses the connection's sample rate.
+             */
+            int outputRate = 0;
+
+            /**
+             * Zero crossings of the sinc kernel on each side. Higher means a
+             * narrower transition band, more CPU and more latency. The stopband
+             * is about 80 dB down either way.
+             */
+            int zeroCrossings = 16;
+
+            /**
+             * Passband edge as a fraction of the lower Nyquist frequency.
+             */
+            double cutoff = 0.9;
+        };
+
+        /**
+         * Streaming polyphase resampler for PCM input (int16, int32 or
+         * float32, interleaved). Converts between any two rates, e.g. 44.1 or
+         * 48 kHz capture to the 16 kHz a connection announced; sample format
+         * and channels are kept.
+         *
+         * Each output sample is a dot product of a Kaiser-windowed sinc phase
+         * with the input around it. Rate pairs whose reduced ratio has up to
+         * kMaxPhases output steps (every common audio rate) use exact phases;
+         * others use the nearest of kMaxPhases. The position is kept as an
+         * exact fraction, so long streams don't drift. Filter state carries
+         * across chunks; output lags input by half the kernel (about 1 ms for
+         * 48 kHz to 16 kHz), which flush() emits.
+         */
+        class DEEPGRAMPP_EXPORT Resampler : public IAudioStage
+        {
+        public:
+            static constexpr int kMaxPhases = 512;
+
+            explicit Resampler(ResamplerOptions options = {});
+
+            AudioFormat configure(const AudioFormat &input, const AudioFormat &wire) override;
+            void process(const std::uint8_t *data, std::size_t size, std::vector<std::uint8_t> &out) override;
+            void flush(std::vector<std::uint8_t> &out) override;
+
+            /**
+             * Taps per phase of the current filter, 0 when passing through.
+             */
+            std::size_t taps() const { return _taps; }
+
+        private:
+            void design();
+            void reset();
+            void append(const std::uint8_t *data, std::size_t frames);
+            void produce(std::uint64_t limit, std::vector<std::uint8_t> &out);
+
+            ResamplerOptions _options;
+            AudioFormat _input;
+            AudioFormat _output;
+            bool _passThrough = true;
+
+            std::size_t _taps = 0;
+            std::size_t _phases = 0;
+            std::vector<float> _coefficients; // _phases rows of _taps
+
+            // Per-channel input; _position is the frame the next output is
+            // centered on, _fraction / outputRate its offset past it.
+            std::vector<std::vector<float>> _history;
+            std::size_t _position = 0;
+            std::uint64_t _fraction = 0;
+            std::uint64_t _framesIn = 0;
+            std::uint64_t _framesOut = 0;
+
+            std::vector<std::uint8_t> _carry;
+            std::vector<float> _staging;
+            std::vector<float> _samples;
+            std::vector<float *> _planes;
+            std::vector<float> _produced;
+        };
+    }
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+#include "format.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace deepgram
+{
+    namespace audio
+    {
+        /**
+         * One step of the pre-send audio pipeline of a streaming client (see
+         * addAudioStage()). Every chunk handed to streamAudio()/pushAudio() runs
+         * through the stages in order before it is sent.
+         *
+         * Stages run on the thread that sends the audio, one chunk at a time;
+         * process() should not lock or allocate in the steady state, since
+         * pushAudio() may be called from an audio-capture callback.
+         */
+        class IAudioStage
+        {
+        public:
+            virtual ~IAudioStage() = default;
+
+            /**
+             * Called at connect(). `input` is the format this stage receives
+             * (the client's input format, or the previous stage's output) and
+             * `wire` the format of the connection's encoding/sample rate/
+             * channels. Returns the format this stage produces. Resets any
+             * state left from a previous session.
+             */
+            virtual AudioFormat configure(const AudioFormat &input, const AudioFormat &wire) = 0;
+
+            /**
+             * Appends the processed form of `size` bytes of input to `out`.
+             * Chunks need not hold whole frames; stages carry partial input over
+             * to the next call.
+             */
+            virtual void process(const std::uint8_t *data, std::size_t size, std::vector<std::uint8_t> &out) = 0;
+
+            /**
+             * End of the stream (Finalize or close): appends whatever output is
+             * still held back, e.g. a filter's tail. The stage then starts over,
+             * as audio may follow a Finalize.
+             */
+            virtual void flush(std::vector<std::uint8_t> & /*out*/) {}
+        };
+    }
+}
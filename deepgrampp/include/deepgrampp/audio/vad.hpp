@@ -0,0 +1,136 @@
+#pragma once
+
+#include <deepgrampp_lib_export.h>
+
+#include "stage.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+namespace deepgram
+{
+    namespace audio
+    {
+        struct VoiceGateOptions
+        {
+            /**
+             * Analysis frame; the gate opens and closes on frame boundaries.
+             */
+            std::chrono::milliseconds frame{20};
+
+            /**
+             * Frames quieter than this (RMS, dBFS) are never speech.
+             */
+            double thresholdDb = -50.0;
+
+            /**
+             * A frame is speech when it is this far above the tracked noise
+             * floor, or half as far with a zero-crossing rate of at least
+             * `zeroCrossingRate` (unvoiced consonants: quiet but noisy).
+             */
+            double snrDb = 12.0;
+            double zeroCrossingRate = 0.25;
+
+            /**
+             * Audio sent ahead of the frame that opens the gate, so word onsets
+             * aren't clipped.
+             */
+            std::chrono::milliseconds preRoll{300};
+
+            /**
+             * Audio still sent after the last speech frame. The server only
+             * finalizes and sends UtteranceEnd after hearing enough silence, so
+             * keep this above the connection's `utterance_end_ms` and
+             * `endpointing`.
+             */
+            std::chrono::milliseconds hangover{1500};
+        };
+
+        /**
+         * Holds back silence: a lightweight energy and zero-crossing voice
+         * activity detector that only passes speech, with pre-roll ahead of it
+         * and hangover after it. Works on PCM (int16, int32, float32) and
+         * G.711, interleaved; other formats pass through.
+         *
+         * The server's clock then only counts the audio it received, so
+         * toStreamTime() maps its timestamps back to the stream's. Give the
+         * gate to ListenWebsocketClient::setVoiceActivityGate() rather than
+         * addAudioStage(): the client then remaps result timestamps and sends
+         * KeepAlive while the gate is closed.
+         */
+        class DEEPGRAMPP_EXPORT VoiceActivityGate : public IAudioStage
+        {
+        public:
+            explicit VoiceActivityGate(VoiceGateOptions options = {});
+
+            AudioFormat configure(const AudioFormat &input, const AudioFormat &wire) override;
+            void process(const std::uint8_t *data, std::size_t size, std::vector<std::uint8_t> &out) override;
+
+            /**
+             * Sends a partial frame left over while the gate is open. The gate
+             * keeps its state and time map; configure() starts those over.
+             */
+            void flush(std::vector<std::uint8_t> &out) override;
+
+            /**
+             * True while audio is being held back.
+             */
+            bool gated() const;
+
+            /**
+             * Seconds of audio held back since configure().
+             */
+            double suppressedSeconds() const;
+
+            /**
+             * Maps a time on the server's clock (seconds of audio it received)
+             * to seconds of audio handed to the gate. Thread-safe.
+             */
+            double toStreamTime(double serverSeconds) const;
+
+        private:
+            struct Segment
+            {
+                std::uint64_t serverFrame; // first frame sent after a gap
+                std::uint64_t streamFrame; // where it is in the input
+            };
+
+            void handleBlock(const std::uint8_t *block, std::vector<std::uint8_t> &out);
+            bool isSpeech(const std::uint8_t *block);
+            void emit(const std::uint8_t *data, std::size_t size, std::vector<std::uint8_t> &out);
+
+            VoiceGateOptions _options;
+            AudioFormat _format;
+            bool _passThrough = true;
+            // A block is one analysis frame; "frames" are sample frames.
+            std::size_t _blockFrames = 0;
+            std::size_t _blockBytes = 0;
+            std::size_t _preRollBlocks = 0;
+            std::size_t _hangoverBlocks = 0;
+
+            bool _open = false;
+            std::size_t _hangoverLeft = 0;
+            double _noiseFloorDb = 0.0;
+            std::uint64_t _inputFrames = 0; // sample frames seen
+            std::uint64_t _sentFrames = 0;  // sample frames passed on
+            std::atomic<bool> _gated{false};
+            std::atomic<std::uint64_t> _suppressedFrames{0};
+
+            std::vector<std::uint8_t> _pending;
+            std::vector<std::uint8_t> _preRoll; // ring of _preRollBlocks blocks
+            std::size_t _preRollHead = 0;
+            std::size_t _preRollCount = 0;
+            std::vector<float> _samples;
+            std::vector<std::int16_t> _pcm16;
+            std::vector<std::int32_t> _pcm32;
+
+            mutable std::mutex _segmentsMutex;
+            std::vector<Segment> _segments;
+            int _sampleRate = 0;
+        };
+    }
+}
@@ -2,9 +2,23 @@
 
 #include "speak-ws.hpp"
 #include "speak-rest.hpp"
+#include "speak-cache.hpp"
 #include "listen-ws.hpp"
 #include "listen-rest.hpp"
+#include "listen-batch.hpp"
+#include "listen-cache.hpp"
 #include "listen-flux.hpp"
+#include "listen-pmr.hpp"
+#include "word-timeline.hpp"
+#include "audio/pacing.hpp"
+#include "audio/push.hpp"
+#include "audio/format.hpp"
+#include "audio/stage.hpp"
+#include "audio/pcm.hpp"
+#include "audio/resampler.hpp"
+#include "audio/g711.hpp"
+#include "audio/vad.hpp"
+#include "audio/opus.hpp"
 #include "listen.hpp"
 
 namespace deepgram
@@ -0,0 +1,129 @@
+#pragma once
+
+#include <deepgrampp_lib_export.h>
+#include "listen.hpp"
+#include "listen-rest.hpp"
+#include "rate-limiter.hpp"
+#include "retry-policy.hpp"
+#include "transport/http_transport.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace deepgram
+{
+    namespace listen
+    {
+        /**
+         * @brief One file to transcribe. An empty `contentType` falls back to
+         * BatchOptions::contentType.
+         */
+        struct BatchItem
+        {
+            std::string path;
+            std::string contentType;
+        };
+
+        /**
+         * @brief Configuration of a BatchTranscriber run.
+         */
+        struct BatchOptions
+        {
+            LiveTranscriptionOptions options;         // Sent with every file
+            std::string contentType = "audio/wav";     // Default MIME type for items that don't set one
+            int concurrency = 8;                        // Worker threads, i.e. requests in flight at once
+            RetryPolicy retryPolicy;                     // Per-file retries, applied by every worker's client
+            std::shared_ptr<RateLimiter> rateLimiter;     // Optional limiter shared by every worker
+
+            /**
+             * JSONL file each result is appended to as soon as it completes:
+             * `{"path", "success", "status_code", "error"?, "response"?}` per line.
+             */
+            std::string outputPath;
+
+            /**
+             * Skip files that already have a successful line in `outputPath`, so
+             * an interrupted run can simply be restarted with the same arguments.
+             */
+            bool resume = true;
+
+            /**
+             * Creates the HTTP transport of each worker. Defaults to a
+             * CurlHttpTransport per worker, all attached to
+             * CurlShareContext::processWide() so they share DNS lookups and
+             * TLS sessions.
+             */
+            std::function<std::shared_ptr<transport::IHttpTransport>()> transportFactory;
+            std::string caFilePath; // Passed to the default transports, see ListenRestClient
+        };
+
+        /**
+         * @brief Progress snapshot passed to the progress callback after each file.
+         */
+        struct BatchProgress
+        {
+            std::size_t total = 0;     // Items in this run, including skipped ones
+            std::size_t completed = 0;  // Processed so far in this run (succeeded + failed)
+            std::size_t succeeded = 0;
+            std::size_t failed = 0;
+            std::size_t skipped = 0;      // Already done according to the checkpoint
+            std::string path;              // The file that just completed
+            bool success = false;
+            long statusCode = 0;
+        };
+
+        using BatchSummary = BatchProgress;
+
+        /**
+         * @brief Transcribes many files in parallel with a bounded pool of
+         * ListenRestClient workers, writing each result to a JSONL file as it
+         * completes and skipping already-finished files on restart.
+         *
+         * run()/runManifest() block until every item has been processed or
+         * cancel() is called; a BatchTranscriber runs one batch at a time.
+         */
+        class DEEPGRAMPP_EXPORT BatchTranscriber
+        {
+        public:
+            using ProgressCallback = std::function<void(const BatchProgress &)>;
+
+            BatchTranscriber(const std::string &apiKey, BatchOptions options);
+            ~BatchTranscriber();
+
+            /**
+             * Invoked from worker threads (serialized, never concurrently) after
+             * every processed file.
+             */
+            void setProgressCallback(ProgressCallback callback);
+
+            BatchSummary run(const std::vector<BatchItem> &items);
+            BatchSummary run(const std::vector<std::string> &paths);
+
+            /**
+             * Reads the items from a manifest: one path per line, or one JSON
+             * object per line with `path` and optional `content_type` keys. Blank
+             * lines and lines starting with '#' are ignored. Throws
+             * std::runtime_error if the manifest can't be read or a JSON line
+             * is malformed (the message names the line).
+             */
+            BatchSummary runManifest(const std::string &manifestPath);
+
+            /**
+             * Stops handing out new files; files already in flight still complete
+             * and are recorded. Safe to call from any thread, including the
+             * progress callback.
+             */
+            void cancel();
+
+        private:
+            std::string _apiKey;
+            BatchOptions _options;
+            ProgressCallback _progressCallback;
+            std::atomic<bool> _cancelled{false};
+        };
+    }
+}
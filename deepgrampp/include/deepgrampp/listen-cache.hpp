@@ -0,0 +1,63 @@
+#pragma once
+
+#include <deepgrampp_lib_export.h>
+#include "listen.hpp"
+
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <string>
+
+namespace deepgram
+{
+    namespace listen
+    {
+        struct TranscriptionCacheState;
+
+        /**
+         * @brief Configuration of a TranscriptionCache.
+         */
+        struct TranscriptionCacheOptions
+        {
+            std::size_t maxMemoryEntries = 256; // Responses kept in the in-memory LRU tier
+
+            /**
+             * Directory of the on-disk tier (one JSON file per response), created
+             * on demand. Empty keeps the cache memory-only. Entries on disk are
+             * never evicted; prune the directory externally if needed.
+             */
+            std::string directory;
+        };
+
+        /**
+         * @brief Content-addressed cache of prerecorded transcription responses,
+         * attached to clients with ListenRestClient::setResultCache().
+         *
+         * Keys are built by the client from a hash of the audio bytes, their
+         * length, the content type and the canonicalized request options, so the
+         * same audio transcribed with the same options is only sent once --
+         * across runs too when `directory` is set. Lookups check memory first,
+         * then disk (promoting disk hits into memory). Safe to share between
+         * clients and threads.
+         */
+        class DEEPGRAMPP_EXPORT TranscriptionCache
+        {
+        public:
+            explicit TranscriptionCache(TranscriptionCacheOptions options = {});
+            ~TranscriptionCache();
+
+            std::optional<PrerecordedTranscriptionResponse> get(const std::string &key);
+            void put(const std::string &key, const PrerecordedTranscriptionResponse &response);
+
+            /**
+             * Drops the memory tier and deletes this cache's files from `directory`.
+             */
+            void clear();
+
+            std::size_t memoryEntries() const;
+
+        private:
+            std::unique_ptr<TranscriptionCacheState> _state;
+        };
+    }
+}
@@ -2,10 +2,19 @@
 #define DEEPGRAMPP_LISTEN_FLUX_HPP
 
 #include <deepgrampp_lib_export.h>
+#include "rate-limiter.hpp"
+#include "audio/pacing.hpp"
+#include "audio/push.hpp"
+#include "audio/stage.hpp"
 #include "transport/websocket_transport.hpp"
 #include <nlohmann/json.hpp>
+#include <chrono>
+#include <functional>
 #include <memory>
+#include <optional>
 #include <sstream>
+#include <string>
+#include <vector>
 
 /**
  * @brief Deepgram Listen Flux API client.
@@ -215,12 +224,65 @@ namespace deepgram {
                  */
                 bool streamAudio(const std::vector<uint8_t>& audioData, int chunkSize = 4096);
 
+                /**
+                 * @brief Streams recorded raw audio at real-time speed (or `pacing.speed` times it),
+                 * the way a live microphone would deliver it. The byte rate comes from the
+                 * encoding and sample rate passed to connect(). Blocks until all audio is sent.
+                 * @param audioData The linear16, linear32, mulaw or alaw audio to stream.
+                 * @param pacing Playback speed and frame duration.
+                 * @return true if the audio data was streamed successfully, false otherwise.
+                 */
+                bool streamAudioPaced(const std::vector<uint8_t>& audioData, const audio::PacingOptions& pacing = {});
+
+                /**
+                 * @brief Queues audio without blocking, e.g. from an audio-capture callback.
+                 * The bytes go into a wait-free single-producer/single-consumer ring that the
+                 * transport's I/O thread drains in frames of PushOptions::frameDuration.
+                 * Call it from one thread at a time, between connect() and close();
+                 * close() and sendCloseStream() may be called from another thread meanwhile.
+                 * @return false, dropping the whole chunk, when not connected, the ring is full,
+                 *         or close() is draining the audio stages on another thread.
+                 */
+                bool pushAudio(const uint8_t* data, size_t size);
+
+                /**
+                 * @brief Sets the frame duration and buffer size used by pushAudio(), from the next connect().
+                 */
+                void setAudioPushOptions(const audio::PushOptions& options);
+
+                /**
+                 * @brief Bytes rejected by pushAudio() because the ring was full, this session.
+                 */
+                std::size_t droppedAudioBytes() const;
+
+                /**
+                 * @brief Declares the format of the audio handed to streamAudio(), streamAudioPaced()
+                 * and pushAudio() when it isn't the connection's (e.g. float32 stereo from a capture
+                 * API). Unless stages were added, an audio::PcmConverter converts it to the mono
+                 * encoding Flux expects and an audio::Resampler to the connection's sample rate; a
+                 * mulaw/alaw connection adds an audio::G711Encoder. Applies from the next connect().
+                 */
+                void setAudioInputFormat(const audio::AudioFormat& format);
+
+                /**
+                 * @brief Appends a stage to the pre-send pipeline, configured at connect(). Stages
+                 * run in order on the sending thread (for pushAudio(), the caller's).
+                 */
+                void addAudioStage(std::shared_ptr<audio::IAudioStage> stage);
+
                 /**
                  * @brief Sends a CloseStream control message to the Deepgram Listen Flux API.
                  * This indicates that no more audio data will be sent and the stream should be closed.
                  */
                 void sendCloseStream();
 
+                /**
+                 * @brief Sets how long closing waits, after CloseStream, for the server to send its
+                 * last events and close the socket. Closing finishes as soon as that happens.
+                 * Default is 5 seconds.
+                 */
+                void setCloseTimeout(std::chrono::milliseconds timeout);
+
                 /**
                  * Callback function types for handling events.
                  */
@@ -246,11 +308,20 @@ namespace deepgram {
                  */
                 void setOnFatalErrorCallback(OnFatalErrorCallback callback);
 
+                /**
+                 * @brief Shares a client-side rate limiter with other clients.
+                 * connect() then waits for a stream permit, held until the session closes.
+                 * @param rateLimiter The limiter to attach, or null to detach.
+                 */
+                void setRateLimiter(std::shared_ptr<RateLimiter> rateLimiter);
+
                 private:
                 std::unique_ptr<ListenFluxClientImpl> _fluxClientImpl;
-                OnTurnInfoCallback _onTurnInfoCallback = [](const event::TurnInfo&) {};
-                OnConnectedCallback _onConnectedCallback = [](const event::Connected&) {};
-                OnFatalErrorCallback _onFatalErrorCallback = [](const event::FatalError&) {};
+                // Left empty until set: events without a callback are skipped
+                // before any decoding happens.
+                OnTurnInfoCallback _onTurnInfoCallback;
+                OnConnectedCallback _onConnectedCallback;
+                OnFatalErrorCallback _onFatalErrorCallback;
             };
         }
     }
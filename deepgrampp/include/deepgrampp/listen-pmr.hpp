@@ -0,0 +1,225 @@
+#pragma once
+
+#include "listen.hpp"
+
+#include <cstddef>
+#include <memory_resource>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace deepgram
+{
+    namespace listen
+    {
+        /**
+         * Allocator-aware mirrors of the transcription result structs. Every
+         * string and vector of a result shares the memory_resource it was
+         * constructed with, which lets the streaming client decode each message
+         * into a per-session arena and drop it wholesale after the callback
+         * instead of freeing each piece (see
+         * ListenWebsocketClient::setOnArenaTranscription()).
+         *
+         * Optional text fields are empty when absent. Use toOwned() to keep a
+         * result beyond the callback that received it.
+         */
+        namespace pmr
+        {
+            using allocator_type = std::pmr::polymorphic_allocator<std::byte>;
+
+            struct Word
+            {
+                using allocator_type = pmr::allocator_type;
+
+                std::pmr::string word;
+                double start = 0.0;
+                double end = 0.0;
+                double confidence = 0.0;
+                std::pmr::string punctuated_word;
+                std::pmr::string speaker;
+                std::pmr::string speakerConfidence;
+
+                Word() = default;
+                Word(const Word &) = default;
+                Word(Word &&) = default;
+                Word &operator=(const Word &) = default;
+                Word &operator=(Word &&) = default;
+
+                explicit Word(const allocator_type &alloc)
+                    : word(alloc), punctuated_word(alloc), speaker(alloc), speakerConfidence(alloc)
+                {
+                }
+
+                Word(const Word &other, const allocator_type &alloc)
+                    : word(other.word, alloc), start(other.start), end(other.end), confidence(other.confidence),
+                      punctuated_word(other.punctuated_word, alloc), speaker(other.speaker, alloc),
+                      speakerConfidence(other.speakerConfidence, alloc)
+                {
+                }
+
+                Word(Word &&other, const allocator_type &alloc)
+                    : word(std::move(other.word), alloc), start(other.start), end(other.end), confidence(other.confidence),
+                      punctuated_word(std::move(other.punctuated_word), alloc), speaker(std::move(other.speaker), alloc),
+                      speakerConfidence(std::move(other.speakerConfidence), alloc)
+                {
+                }
+
+                listen::Word toOwned() const
+                {
+                    listen::Word w;
+                    w.word.assign(word.data(), word.size());
+                    w.start = start;
+                    w.end = end;
+                    w.confidence = confidence;
+                    if (!punctuated_word.empty())
+                    {
+                        w.punctuated_word.emplace(punctuated_word.data(), punctuated_word.size());
+                    }
+                    if (!speaker.empty())
+                    {
+                        w.speaker.emplace(speaker.data(), speaker.size());
+                    }
+                    if (!speakerConfidence.empty())
+                    {
+                        w.speakerConfidence.emplace(speakerConfidence.data(), speakerConfidence.size());
+                    }
+                    return w;
+                }
+            };
+
+            struct Alternative
+            {
+                using allocator_type = pmr::allocator_type;
+
+                std::pmr::string transcript;
+                double confidence = 0.0;
+                std::pmr::vector<Word> words;
+                std::pmr::string language;
+
+                Alternative() = default;
+                Alternative(const Alternative &) = default;
+                Alternative(Alternative &&) = default;
+                Alternative &operator=(const Alternative &) = default;
+                Alternative &operator=(Alternative &&) = default;
+
+                explicit Alternative(const allocator_type &alloc)
+                    : transcript(alloc), words(alloc), language(alloc)
+                {
+                }
+
+                Alternative(const Alternative &other, const allocator_type &alloc)
+                    : transcript(other.transcript, alloc), confidence(other.confidence),
+                      words(other.words, alloc), language(other.language, alloc)
+                {
+                }
+
+                Alternative(Alternative &&other, const allocator_type &alloc)
+                    : transcript(std::move(other.transcript), alloc), confidence(other.confidence),
+                      words(std::move(other.words), alloc), language(std::move(other.language), alloc)
+                {
+                }
+
+                listen::Alternative toOwned() const
+                {
+                    listen::Alternative alt;
+                    alt.transcript.assign(transcript.data(), transcript.size());
+                    alt.confidence = confidence;
+                    alt.words.reserve(words.size());
+                    for (const auto &w : words)
+                    {
+                        alt.words.push_back(w.toOwned());
+                    }
+                    if (!language.empty())
+                    {
+                        alt.language.emplace(language.data(), language.size());
+                    }
+                    return alt;
+                }
+            };
+
+            struct Channel
+            {
+                using allocator_type = pmr::allocator_type;
+
+                std::pmr::vector<Alternative> alternatives;
+
+                Channel() = default;
+                Channel(const Channel &) = default;
+                Channel(Channel &&) = default;
+                Channel &operator=(const Channel &) = default;
+                Channel &operator=(Channel &&) = default;
+
+                explicit Channel(const allocator_type &alloc)
+                    : alternatives(alloc)
+                {
+                }
+
+                Channel(const Channel &other, const allocator_type &alloc)
+                    : alternatives(other.alternatives, alloc)
+                {
+                }
+
+                Channel(Channel &&other, const allocator_type &alloc)
+                    : alternatives(std::move(other.alternatives), alloc)
+                {
+                }
+
+                listen::Channel toOwned() const
+                {
+                    listen::Channel ch;
+                    ch.alternatives.reserve(alternatives.size());
+                    for (const auto &alt : alternatives)
+                    {
+                        ch.alternatives.push_back(alt.toOwned());
+                    }
+                    return ch;
+                }
+            };
+
+            struct TranscriptionResult
+            {
+                using allocator_type = pmr::allocator_type;
+
+                std::pmr::string type;
+                Channel channel;
+                bool isFinal = false;
+                bool speech_final = false;
+                bool isFromFinalize = false;
+                std::optional<double> duration;
+                std::optional<double> start;
+
+                TranscriptionResult() = default;
+                TranscriptionResult(const TranscriptionResult &) = default;
+                TranscriptionResult(TranscriptionResult &&) = default;
+                TranscriptionResult &operator=(const TranscriptionResult &) = default;
+                TranscriptionResult &operator=(TranscriptionResult &&) = default;
+
+                explicit TranscriptionResult(const allocator_type &alloc)
+                    : type(alloc), channel(alloc)
+                {
+                }
+
+                TranscriptionResult(const TranscriptionResult &other, const allocator_type &alloc)
+                    : type(other.type, alloc), channel(other.channel, alloc), isFinal(other.isFinal),
+                      speech_final(other.speech_final), isFromFinalize(other.isFromFinalize),
+                      duration(other.duration), start(other.start)
+                {
+                }
+
+                listen::TranscriptionResult toOwned() const
+                {
+                    listen::TranscriptionResult result;
+                    result.type.assign(type.data(), type.size());
+                    result.channel = channel.toOwned();
+                    result.isFinal = isFinal;
+                    result.speech_final = speech_final;
+                    result.isFromFinalize = isFromFinalize;
+                    result.duration = duration;
+                    result.start = start;
+                    return result;
+                }
+            };
+        }
+    }
+}
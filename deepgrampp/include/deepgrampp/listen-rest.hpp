@@ -2,6 +2,9 @@
 
 #include <deepgrampp_lib_export.h>
 #include "listen.hpp"
+#include "listen-cache.hpp"
+#include "rate-limiter.hpp"
+#include "retry-policy.hpp"
 #include "transport/http_transport.hpp"
 
 #include <memory>
@@ -25,10 +28,24 @@ namespace deepgram
             long statusCode = 0;
             std::string errorMessage;
             PrerecordedTranscriptionResponse response;
+            bool fromCache = false; // Served by the client's TranscriptionCache, no request was made
 
             explicit operator bool() const { return success; }
         };
 
+        /**
+         * @brief How ListenRestClient::transcribeSegmented() cuts a long raw PCM
+         * recording into pieces that are transcribed concurrently.
+         */
+        struct SegmentationOptions
+        {
+            double segmentSeconds = 300.0;  // Nominal length of each segment
+            double overlapSeconds = 4.0;     // Audio shared by neighbouring segments, split evenly around each cut
+            bool splitOnSilence = true;       // Move each cut to the quietest spot before the nominal boundary
+            double silenceSearchSeconds = 10.0; // How far back from the nominal boundary to look for that spot
+            int concurrency = 4;                // Segment requests in flight at once
+        };
+
         /**
          * @brief REST client for Deepgram's prerecorded/batch transcription API
          * (POST /v1/listen). Unlike ListenWebsocketClient, this issues a single
@@ -94,6 +111,58 @@ namespace deepgram
                                                             const std::string &contentType,
                                                             const LiveTranscriptionOptions &options = {});
 
+            /**
+             * @brief Transcribes a long headerless LINEAR_16 recording by splitting
+             * it into overlapping segments (see SegmentationOptions), sending them
+             * concurrently and stitching the results back into one response.
+             *
+             * Word timestamps are shifted back onto the original timeline and
+             * words transcribed twice in an overlap are kept only once. The merged
+             * response has a single alternative per channel whose transcript is
+             * rebuilt from its words, so keep word output enabled. The request
+             * fails as a whole if any segment fails (after the retry policy).
+             *
+             * @param audioData Raw little-endian 16-bit PCM described by
+             *        `options.sampleRate` and `options.channels`.
+             *
+             * @note Segments are sent concurrently over this client's transport,
+             *       which must therefore support concurrent send() calls (the
+             *       default CurlHttpTransport does).
+             */
+            PrerecordedTranscriptionResult transcribeSegmented(const std::vector<uint8_t> &audioData,
+                                                                 const LiveTranscriptionOptions &options = {},
+                                                                 const SegmentationOptions &segmentation = {});
+
+            /**
+             * @brief Sets how failed requests are retried and/or hedged (see
+             * RetryPolicy). The default is a single attempt. Configure it before
+             * issuing requests; it isn't synchronized with calls in flight.
+             */
+            void setRetryPolicy(const RetryPolicy &policy);
+
+            /**
+             * @brief Shares a client-side rate limiter with other clients; every
+             * request attempt waits for a permit first. Pass null to detach. Same
+             * caveat as setRetryPolicy().
+             */
+            void setRateLimiter(std::shared_ptr<RateLimiter> rateLimiter);
+
+            /**
+             * @brief Serves transcribeBuffer()/transcribeFile() (and each segment of
+             * transcribeSegmented()) from `cache` when the same audio was already
+             * transcribed with the same options, and stores every successful
+             * response in it. Pass null to detach. Same caveat as setRetryPolicy().
+             */
+            void setResultCache(std::shared_ptr<TranscriptionCache> cache);
+
+            /**
+             * @brief Limits which fields of responses are decoded (see
+             * DecodeProfile). Defaults to DecodeProfile::Full. transcribeSegmented()
+             * still decodes each segment in full to stitch them, and trims the
+             * merged response afterwards. Same caveat as setRetryPolicy().
+             */
+            void setDecodeProfile(DecodeProfile profile);
+
         private:
             std::unique_ptr<ListenRestClientImpl> impl_;
         };
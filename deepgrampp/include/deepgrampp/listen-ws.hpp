@@ -2,11 +2,19 @@
 
 #include <deepgrampp_lib_export.h>
 #include "listen.hpp"
+#include "listen-pmr.hpp"
 #include "deepgram.hpp"
+#include "rate-limiter.hpp"
+#include "audio/pacing.hpp"
+#include "audio/opus.hpp"
+#include "audio/push.hpp"
+#include "audio/stage.hpp"
+#include "audio/vad.hpp"
 #include "transport/websocket_transport.hpp"
 
 #include <nlohmann/json.hpp>
 
+#include <chrono>
 #include <memory>
 
 namespace deepgram
@@ -66,33 +74,177 @@ namespace deepgram
             void startKeepalive();
             bool streamAudio(const std::vector<uint8_t> &audioData, int chunkSize=4096);
 
+            /**
+             * Streams recorded raw audio (linear16, linear32, mulaw or alaw) at
+             * real-time speed, or `pacing.speed` times it, so the server sees it
+             * the way it would see a live microphone and interim results arrive
+             * as they would in production. The byte rate comes from the
+             * encoding, sample rate and channels passed to connect(). Blocks
+             * until all audio is sent.
+             */
+            bool streamAudioPaced(const std::vector<uint8_t> &audioData, const audio::PacingOptions &pacing = {});
+
+            /**
+             * Queues audio without blocking, for callers such as audio-capture
+             * callbacks that must never wait. The bytes go into a wait-free
+             * single-producer/single-consumer ring owned by the session, which
+             * the transport's I/O thread drains in frames of
+             * PushOptions::frameDuration. Call it from one thread at a time,
+             * between connect() and close(); don't mix it with streamAudio().
+             * sendFinalizeMessage() and close() may be called from another
+             * thread while it runs.
+             *
+             * @return false, dropping the whole chunk, when not connected, the
+             *         ring is full, or sendFinalizeMessage()/close() are
+             *         draining the audio stages on another thread (see
+             *         droppedAudioBytes()).
+             */
+            bool pushAudio(const uint8_t *data, size_t size);
+            void setAudioPushOptions(const audio::PushOptions &options);
+            std::size_t droppedAudioBytes() const;
+
+            /**
+             * Format of the audio handed to streamAudio(), streamAudioPaced()
+             * and pushAudio(), when it isn't what the connection's encoding,
+             * sample rate and channels describe -- e.g. float32 stereo from a
+             * capture API on a linear16 mono connection. Unless stages were
+             * added, an audio::PcmConverter then converts it, and an
+             * audio::Resampler brings it to the connection's sample rate, e.g.
+             * 48 kHz capture to 16 kHz. On a mulaw/alaw connection an
+             * audio::G711Encoder compresses the result. Applies from the next
+             * connect().
+             */
+            void setAudioInputFormat(const audio::AudioFormat &format);
+
+            /**
+             * Appends a stage to the pre-send pipeline; every chunk runs
+             * through the stages in order, from the input format to the
+             * connection's. Stages run on the sending thread (for pushAudio(),
+             * the caller's) and are configured at connect().
+             */
+            void addAudioStage(std::shared_ptr<audio::IAudioStage> stage);
+
+            /**
+             * Holds silence back instead of uploading it (see
+             * audio::VoiceActivityGate), which saves bandwidth and billed audio
+             * on calls that are mostly silent. While the gate is closed a
+             * KeepAlive goes out every 5 seconds in place of audio: connect()
+             * starts the keepalive timer, as startKeepalive() would, so the
+             * sending thread never waits on it. Timestamps
+             * in results, UtteranceEnd and SpeechStarted are mapped back to
+             * the audio you sent, so they stay continuous across the gaps.
+             * Runs after the converter and resampler, ahead of G.711 encoding.
+             * Applies from the next connect(); pass null to remove it.
+             */
+            void setVoiceActivityGate(std::shared_ptr<audio::VoiceActivityGate> gate);
+
+#if defined(DEEPGRAMPP_WITH_OPUS)
+            /**
+             * Compresses the audio with Opus before upload, typically a tenth
+             * of the linear16 bytes or less. The connection options then
+             * describe the PCM you send (or what the converter and resampler
+             * make of it) and the encoder replaces it on the wire: connect()
+             * sends encoding=ogg-opus or opus instead, at the same sample rate
+             * when Opus supports it and 48 kHz otherwise. Raw packets go out
+             * one per message, so they only work with streamAudio() and
+             * streamAudioPaced(); pushAudio() needs the Ogg container. Applies
+             * from the next connect(); pass null to remove it.
+             */
+            void setOpusEncoder(std::shared_ptr<audio::OpusEncoderStage> encoder);
+#endif
+
             /**
              * Use the Finalize message to flush the WebSocket stream.
              * This forces the server to immediately process any unprocessed audio data and return the final transcription results.
+             * Audio the stages still hold is sent first. Safe to call from any
+             * thread, including while another thread is in pushAudio() or
+             * streamAudio().
              */
             bool sendFinalizeMessage();
 
             using PartialTranscriptionCallback = std::function<void(const TranscriptionResult &)>;
             using FinalTranscriptionCallback = std::function<void(const TranscriptionResult &)>;
-            using MetadataCallback = std::function<void(const nlohmann::json &)>;
+            using MetadataCallback = std::function<void(const Metadata &)>;
+            using RawMetadataCallback = std::function<void(const nlohmann::json &)>;
             using ErrorCallback = std::function<void(const std::string &)>;
             using SpeechStartedCallback = std::function<void(const SpeechStarted &)>;
             using UtteranceEndCallback = std::function<void(const UtteranceEnd &)>;
+            using TranscriptViewCallback = std::function<void(const TranscriptView &)>;
+            using ArenaTranscriptionCallback = std::function<void(const pmr::TranscriptionResult &)>;
 
             void setOnPartialTranscription(PartialTranscriptionCallback cb);
             void setOnFinalTranscription(FinalTranscriptionCallback cb);
             void setOnMetadata(MetadataCallback cb);
+
+            /**
+             * Opt-in: receives the Metadata message as parsed JSON, for fields
+             * Metadata doesn't model. Only when this is set is a DOM built;
+             * setOnMetadata() alone decodes straight into Metadata.
+             */
+            void setOnRawMetadata(RawMetadataCallback cb);
             void setOnError(ErrorCallback cb);
             void setOnSpeechStarted(SpeechStartedCallback cb);
             void setUtteranceEndCallback(UtteranceEndCallback cb);
 
+            /**
+             * Receives a TranscriptView of every Results message, partial or
+             * final, decoded once and shared with the partial/final callbacks.
+             * The view points into a result that lives only for the duration of
+             * the callback.
+             */
+            void setOnTranscriptView(TranscriptViewCallback cb);
+
+            /**
+             * Receives every Results message, partial or final, decoded with the
+             * SAX decoder into a per-session arena that is reset as soon as the
+             * callback returns: no per-message heap allocations once the arena
+             * has grown to fit the largest message. The result and everything it
+             * references are only valid during the callback; call toOwned() to
+             * keep one. Honors setDecodeProfile(). Independent of the partial/final
+             * callbacks, which still get their own decode if also set.
+             */
+            void setOnArenaTranscription(ArenaTranscriptionCallback cb);
+
+            /**
+             * Shares a client-side rate limiter with other clients: connect() then
+             * waits for a stream permit, held until the session closes. Pass null
+             * to detach.
+             */
+            void setRateLimiter(std::shared_ptr<RateLimiter> rateLimiter);
+
+            /**
+             * Selects the JSON decoder for incoming messages (see JsonBackend).
+             * Defaults to JsonBackend::Dom. Set it before connect().
+             */
+            void setJsonBackend(JsonBackend backend);
+
+            /**
+             * Limits which fields of Results messages are decoded (see
+             * DecodeProfile), with either JSON backend. Defaults to
+             * DecodeProfile::Full. Set it before connect().
+             */
+            void setDecodeProfile(DecodeProfile profile);
+
             /**
              * @deprecated Message delivery stops automatically when close() is called.
              * Kept as a no-op for source compatibility.
              */
             void stopReceiving();
+
+            /**
+             * Sends CloseStream and waits for the server's final results and
+             * Metadata (or its close frame) before closing the socket, for at
+             * most the close timeout. Like sendFinalizeMessage(), it may be
+             * called while another thread is still sending audio.
+             */
             void close();
 
+            /**
+             * Upper bound on how long close() waits for the final Metadata.
+             * close() returns as soon as it arrives. Default is 5 seconds.
+             */
+            void setCloseTimeout(std::chrono::milliseconds timeout);
+
         private:
             bool sendAudioChunk(const uint8_t *data, size_t size);
 
@@ -103,12 +255,20 @@ namespace deepgram
         private:
             std::unique_ptr<ListenWebsocketClientImpl> websocketClientImpl_;
 
-            PartialTranscriptionCallback onPartialTranscription_ = [](const TranscriptionResult &) {};
-            FinalTranscriptionCallback onFinalTranscription_ = [](const TranscriptionResult &) {};
-            MetadataCallback onMetadata_ = [](const nlohmann::json &) {};
-            ErrorCallback onError_ = [](const std::string &) {};
-            UtteranceEndCallback onUtteranceEnd_ = [](const UtteranceEnd &) {};
-            SpeechStartedCallback onSpeechStarted_ = [](const SpeechStarted &) {};
+            // Left empty until set: message types without a callback are
+            // skipped before any decoding happens.
+            PartialTranscriptionCallback onPartialTranscription_;
+            FinalTranscriptionCallback onFinalTranscription_;
+            MetadataCallback onMetadata_;
+            RawMetadataCallback onRawMetadata_;
+            ErrorCallback onError_;
+            UtteranceEndCallback onUtteranceEnd_;
+            SpeechStartedCallback onSpeechStarted_;
+            TranscriptViewCallback onTranscriptView_;
+            ArenaTranscriptionCallback onArenaTranscription_;
+
+            JsonBackend jsonBackend_ = JsonBackend::Dom;
+            DecodeProfile decodeProfile_ = DecodeProfile::Full;
         };
 
     }
@@ -1,5 +1,9 @@
 #pragma once
+#include <cstddef>
 #include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
 #include <sstream>
 #include <iostream>
 #include <optional>
@@ -477,6 +481,24 @@ namespace deepgram
                 return w;
             }
 
+            nlohmann::json toJson() const
+            {
+                nlohmann::json j = {{"word", word}, {"start", start}, {"end", end}, {"confidence", confidence}};
+                if (punctuated_word.has_value())
+                {
+                    j["punctuated_word"] = punctuated_word.value();
+                }
+                if (speaker.has_value())
+                {
+                    j["speaker"] = speaker.value();
+                }
+                if (speakerConfidence.has_value())
+                {
+                    j["speaker_confidence"] = speakerConfidence.value();
+                }
+                return j;
+            }
+
             void print() const
             {
                 std::cout << "  Word: '" << word << "' [" << start << "s - " << end << "s] "
@@ -528,6 +550,20 @@ namespace deepgram
                 return alt;
             }
 
+            nlohmann::json toJson() const
+            {
+                nlohmann::json j = {{"transcript", transcript}, {"confidence", confidence}, {"words", nlohmann::json::array()}};
+                for (const auto &word : words)
+                {
+                    j["words"].push_back(word.toJson());
+                }
+                if (language.has_value())
+                {
+                    j["language"] = language.value();
+                }
+                return j;
+            }
+
             void print() const
             {
                 std::cout << "  Transcript: \"" << transcript << "\"" << std::endl;
@@ -570,6 +606,16 @@ namespace deepgram
                 return ch;
             }
 
+            nlohmann::json toJson() const
+            {
+                nlohmann::json j = {{"alternatives", nlohmann::json::array()}};
+                for (const auto &alt : alternatives)
+                {
+                    j["alternatives"].push_back(alt.toJson());
+                }
+                return j;
+            }
+
             void print() const
             {
                 std::cout << "Channel with " << alternatives.size() << " alternatives:" << std::endl;
@@ -581,6 +627,34 @@ namespace deepgram
             }
         };
 
+        /**
+         * ModelInfo
+         * @note Describes one model that served a request, as listed under
+         * `model_info` in metadata (keyed there by `uuid`).
+         */
+        struct ModelInfo
+        {
+            std::string uuid;
+            std::string name;
+            std::string version;
+            std::string arch;
+
+            static ModelInfo fromJson(const std::string &uuid, const nlohmann::json &j)
+            {
+                ModelInfo info;
+                info.uuid = uuid;
+                info.name = j.value("name", "");
+                info.version = j.value("version", "");
+                info.arch = j.value("arch", "");
+                return info;
+            }
+
+            nlohmann::json toJson() const
+            {
+                return {{"name", name}, {"version", version}, {"arch", arch}};
+            }
+        };
+
         /**
          * Metadata
          * @note Represents metadata about the connection to the Deepgram API.
@@ -593,8 +667,10 @@ namespace deepgram
             std::string request_id;
             std::string sha256;
             std::string created;
-            double duration;
-            int channels;
+            double duration = 0.0;
+            int channels = 0;
+            std::vector<std::string> models;   // UUIDs of the models used
+            std::vector<ModelInfo> model_info; // Details of each entry in `models`, when provided
 
             static Metadata fromJson(const nlohmann::json &j)
             {
@@ -605,9 +681,52 @@ namespace deepgram
                 meta.created = j.value("created", "");
                 meta.duration = j.value("duration", 0.0);
                 meta.channels = j.value("channels", 0);
+                if (j.contains("models") && j["models"].is_array())
+                {
+                    for (const auto &model : j["models"])
+                    {
+                        if (model.is_string())
+                        {
+                            meta.models.push_back(model.get<std::string>());
+                        }
+                    }
+                }
+                if (j.contains("model_info") && j["model_info"].is_object())
+                {
+                    for (const auto &[uuid, info] : j["model_info"].items())
+                    {
+                        if (info.is_object())
+                        {
+                            meta.model_info.push_back(ModelInfo::fromJson(uuid, info));
+                        }
+                    }
+                }
                 return meta;
             }
 
+            nlohmann::json toJson() const
+            {
+                nlohmann::json j = {{"transaction_key", transaction_key},
+                                    {"request_id", request_id},
+                                    {"sha256", sha256},
+                                    {"created", created},
+                                    {"duration", duration},
+                                    {"channels", channels}};
+                if (!models.empty())
+                {
+                    j["models"] = models;
+                }
+                if (!model_info.empty())
+                {
+                    j["model_info"] = nlohmann::json::object();
+                    for (const auto &info : model_info)
+                    {
+                        j["model_info"][info.uuid] = info.toJson();
+                    }
+                }
+                return j;
+            }
+
             void print() const
             {
                 std::cout << "\n=== CONNECTION METADATA ===" << std::endl;
@@ -615,6 +734,10 @@ namespace deepgram
                 std::cout << "Duration: " << duration << "s" << std::endl;
                 std::cout << "Channels: " << channels << std::endl;
                 std::cout << "Created: " << created << std::endl;
+                for (const auto &info : model_info)
+                {
+                    std::cout << "Model: " << info.name << " " << info.version << " (" << info.arch << ")" << std::endl;
+                }
                 std::cout << "==========================\n"
                           << std::endl;
             }
@@ -649,6 +772,19 @@ namespace deepgram
                 }
                 return response;
             }
+
+            /**
+             * Inverse of fromJson(), limited to the fields modelled here.
+             */
+            nlohmann::json toJson() const
+            {
+                nlohmann::json j = {{"metadata", metadata.toJson()}, {"results", {{"channels", nlohmann::json::array()}}}};
+                for (const auto &channel : channels)
+                {
+                    j["results"]["channels"].push_back(channel.toJson());
+                }
+                return j;
+            }
         };
 
         /**
@@ -662,6 +798,66 @@ namespace deepgram
             constexpr const char *SPEECH_STARTED = "SpeechStarted";
         };
 
+        /**
+         * JsonBackend
+         * @note Selects how streaming clients decode server messages.
+         * `Dom` parses each message into an nlohmann::json tree and walks it with
+         * the fromJson() helpers. `Sax` fills the result structs straight from
+         * the token stream without building a tree, which saves most of the
+         * per-message allocations on interim-heavy streams.
+         */
+        enum class JsonBackend
+        {
+            Dom,
+            Sax
+        };
+
+        /**
+         * DecodeProfile
+         * @note Selects how much of each transcription result is decoded.
+         * `TranscriptOnly` fills transcripts and confidences but leaves
+         * `Alternative::words` empty. `WordsTimings` adds each word's text,
+         * start, end and confidence, without punctuated_word/speaker fields.
+         * `Full` decodes everything. Skipped subtrees are never materialized,
+         * which is what makes the lighter profiles cheap on interim-heavy streams.
+         */
+        enum class DecodeProfile
+        {
+            TranscriptOnly,
+            WordsTimings,
+            Full
+        };
+
+        /**
+         * Span
+         * @note Minimal read-only std::span stand-in (the library targets
+         * C++17): a pointer and a length over contiguous elements it doesn't own.
+         */
+        template <typename T>
+        class Span
+        {
+        public:
+            constexpr Span() = default;
+            constexpr Span(T *data, std::size_t size) : _data(data), _size(size) {}
+            template <typename Allocator>
+            Span(const std::vector<std::remove_const_t<T>, Allocator> &v) : _data(v.data()), _size(v.size()) {}
+
+            constexpr T *data() const { return _data; }
+            constexpr std::size_t size() const { return _size; }
+            constexpr bool empty() const { return _size == 0; }
+            constexpr T *begin() const { return _data; }
+            constexpr T *end() const { return _data + _size; }
+            constexpr T &operator[](std::size_t i) const { return _data[i]; }
+            constexpr T &front() const { return _data[0]; }
+            constexpr T &back() const { return _data[_size - 1]; }
+
+        private:
+            T *_data = nullptr;
+            std::size_t _size = 0;
+        };
+
+        struct TranscriptView;
+
         /**
          * TranscriptionResult
          * @note Represents a transcription result from the Deepgram API.
@@ -721,14 +917,16 @@ namespace deepgram
                           << std::endl;
             }
 
-            // Helper methods for easy access
-            std::string getBestTranscript() const
+            // Helper methods for easy access. They return references into this
+            // result (valid as long as it is), so hot callbacks don't copy.
+            const std::string &getBestTranscript() const
             {
                 if (!channel.alternatives.empty())
                 {
                     return channel.alternatives[0].transcript;
                 }
-                return "";
+                static const std::string empty;
+                return empty;
             }
 
             double getBestConfidence() const
@@ -740,16 +938,54 @@ namespace deepgram
                 return 0.0;
             }
 
-            std::vector<Word> getWords() const
+            const std::vector<Word> &getWords() const
             {
                 if (!channel.alternatives.empty())
                 {
                     return channel.alternatives[0].words;
                 }
-                return {};
+                static const std::vector<Word> empty;
+                return empty;
             }
+
+            TranscriptView view() const;
         };
 
+        /**
+         * TranscriptView
+         * @note Non-owning view of the fields of a TranscriptionResult that
+         * callbacks usually inspect: the best alternative's transcript,
+         * confidence and words, plus the result flags. Valid only as long as the
+         * result it was taken from; copy what you need to keep.
+         */
+        struct TranscriptView
+        {
+            std::string_view type;
+            std::string_view transcript;
+            double confidence = 0.0;
+            Span<const Word> words;
+            bool isFinal = false;
+            bool speech_final = false;
+            bool isFromFinalize = false;
+            std::optional<double> duration;
+            std::optional<double> start;
+        };
+
+        inline TranscriptView TranscriptionResult::view() const
+        {
+            TranscriptView v;
+            v.type = type;
+            v.transcript = getBestTranscript();
+            v.confidence = getBestConfidence();
+            v.words = Span<const Word>(getWords());
+            v.isFinal = isFinal;
+            v.speech_final = speech_final;
+            v.isFromFinalize = isFromFinalize;
+            v.duration = duration;
+            v.start = start;
+            return v;
+        }
+
         /**
          * UtteranceEnd
          * @note Represents the end of an utterance in a transcription stream.
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <deepgrampp_lib_export.h>
+
+#include <memory>
+
+namespace deepgram
+{
+    /**
+     * RateLimiterOptions
+     * @note Client-side limits enforced by a RateLimiter. Zero means "no limit"
+     *       for every field.
+     */
+    struct RateLimiterOptions
+    {
+        int maxConcurrentStreams = 0;   // Open WebSocket sessions (listen, speak, flux)
+        int maxInFlightRequests = 0;     // REST requests currently waiting on a response
+        double requestsPerSecond = 0.0;   // Sustained rate of new requests and stream connects
+        int burst = 1;                     // Token bucket capacity for requestsPerSecond
+    };
+
+    struct RateLimiterState;
+
+    /**
+     * Token-bucket rate limiter and concurrency governor that can be shared by
+     * any number of ListenRestClient, SpeakRestClient, ListenWebsocketClient,
+     * SpeakWebsocketClient and ListenFluxClient instances (see their
+     * setRateLimiter()), so that together they stay under an account's limits
+     * instead of discovering them through 429s.
+     *
+     * Every REST attempt and every stream connect consumes one token; REST
+     * attempts additionally hold an in-flight slot until their response
+     * arrives, and streams hold a stream slot until they close. Excess work
+     * blocks the calling thread and is admitted in FIFO order per kind.
+     *
+     * Thread-safe.
+     */
+    class DEEPGRAMPP_EXPORT RateLimiter
+    {
+    public:
+        /**
+         * RAII handle for an acquired slot; releases it when destroyed. Stays
+         * valid even if the RateLimiter itself is destroyed first.
+         */
+        class DEEPGRAMPP_EXPORT Permit
+        {
+        public:
+            Permit() = default;
+            Permit(Permit &&other) noexcept;
+            Permit &operator=(Permit &&other) noexcept;
+            Permit(const Permit &) = delete;
+            Permit &operator=(const Permit &) = delete;
+            ~Permit();
+
+            void release();
+            explicit operator bool() const { return _state != nullptr; }
+
+        private:
+            friend class RateLimiter;
+            Permit(std::shared_ptr<RateLimiterState> state, bool stream);
+
+            std::shared_ptr<RateLimiterState> _state;
+            bool _stream = false;
+        };
+
+        explicit RateLimiter(const RateLimiterOptions &options);
+        ~RateLimiter();
+
+        /**
+         * Blocks until a REST request may be sent.
+         */
+        Permit acquireRequest();
+
+        /**
+         * Blocks until a streaming session may be opened.
+         */
+        Permit acquireStream();
+
+        int activeStreams() const;
+        int inFlightRequests() const;
+
+    private:
+        std::shared_ptr<RateLimiterState> _state;
+    };
+} // namespace deepgram
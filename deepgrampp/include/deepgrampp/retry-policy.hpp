@@ -0,0 +1,58 @@
+#pragma once
+
+#include <chrono>
+#include <optional>
+
+namespace deepgram
+{
+    /**
+     * RetryPolicy
+     * @note Controls how the REST clients (ListenRestClient, SpeakRestClient)
+     *       react to transient failures. The defaults keep the historical
+     *       behaviour: a single attempt, no hedging.
+     *
+     *       A request is retried when the transport throws (DNS, TLS, timeouts,
+     *       ...) or the server answers 429 or 5xx. The delay before retry `n`
+     *       (1-based) is `initialBackoff * backoffMultiplier^(n-1)`, capped at
+     *       `maxBackoff` and randomly shortened by up to `jitter` of itself so that
+     *       many clients failing together don't retry in lockstep. A `Retry-After`
+     *       header (in seconds) overrides the computed delay when present, as
+     *       given: `maxBackoff` doesn't cap it. When it asks for longer than
+     *       `maxRetryAfter` the request isn't retried and that response is
+     *       returned.
+     */
+    struct RetryPolicy
+    {
+        int maxAttempts = 1;                                  // Total attempts, including the first one
+        std::chrono::milliseconds initialBackoff{250};         // Delay before the first retry
+        std::chrono::milliseconds maxBackoff{10000};           // Upper bound for any single delay
+        double backoffMultiplier = 2.0;                         // Growth factor between consecutive delays
+        double jitter = 0.5;                                     // Fraction [0, 1] of each delay that is randomized
+        bool retryOnTransportError = true;                        // Retry when the transport itself throws
+        bool respectRetryAfter = true;                             // Honour the server's Retry-After header
+        std::chrono::milliseconds maxRetryAfter{60000};             // Longest Retry-After waited for; longer gives up
+
+        /**
+         * Request hedging: if an attempt hasn't completed after this long, an
+         * identical request is fired alongside it and whichever answers first
+         * with a non-retryable status wins (the loser is left to finish in the
+         * background and discarded). A retryable reply only ends the race once
+         * no other attempt is still running.
+         * Set it to roughly the endpoint's p95 latency to cut off the slow tail
+         * at the cost of ~5% extra requests.
+         *
+         * @note The transport interface is synchronous, so "answered" means the
+         *       full response arrived, not just its first byte. Hedged attempts
+         *       call the transport concurrently, which CurlHttpTransport
+         *       supports; custom transports must too. Mainly meant for short
+         *       requests such as text-to-speech -- hedging a large upload doubles
+         *       its bandwidth and may double its billing.
+         */
+        std::optional<std::chrono::milliseconds> hedgeAfter;
+
+        bool isRetryableStatus(long statusCode) const
+        {
+            return statusCode == 429 || (statusCode >= 500 && statusCode < 600);
+        }
+    };
+} // namespace deepgram
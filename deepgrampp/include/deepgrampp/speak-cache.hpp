@@ -0,0 +1,113 @@
+#pragma once
+
+#include <deepgrampp_lib_export.h>
+#include "speak.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace deepgram
+{
+    namespace speak
+    {
+        struct SpeechCacheState;
+
+        /**
+         * @brief Which API synthesized a cache entry. REST answers are whole
+         * files (e.g. WAV for linear16) while the WebSocket API streams
+         * headerless frames, so the two never share entries.
+         */
+        enum class SpeechSource
+        {
+            Rest,
+            Websocket
+        };
+
+        /**
+         * @brief Configuration of a SpeechCache.
+         */
+        struct SpeechCacheOptions
+        {
+            std::size_t maxMemoryBytes = 64 * 1024 * 1024; // Audio bytes kept by the in-memory LRU tier
+
+            /**
+             * Directory of the persistent tier (one file per synthesized text),
+             * created on demand; empty keeps the cache memory-only. Disk hits are
+             * memory-mapped rather than read, and their pages count against
+             * `maxMemoryBytes` while they stay in the memory tier. Files are never
+             * evicted; prune the directory externally if needed.
+             */
+            std::string directory;
+        };
+
+        /**
+         * @brief Immutable synthesized audio held by a SpeechCache, either in a
+         * heap buffer or in a read-only mapping of its cache file.
+         */
+        class DEEPGRAMPP_EXPORT CachedSpeech
+        {
+        public:
+            CachedSpeech(std::shared_ptr<const void> owner, const std::uint8_t *data, std::size_t size, std::string contentType)
+                : _owner(std::move(owner)), _data(data), _size(size), _contentType(std::move(contentType))
+            {
+            }
+
+            const std::uint8_t *data() const { return _data; }
+            std::size_t size() const { return _size; }
+            const std::string &contentType() const { return _contentType; }
+
+        private:
+            std::shared_ptr<const void> _owner;
+            const std::uint8_t *_data;
+            std::size_t _size;
+            std::string _contentType;
+        };
+
+        /**
+         * @brief Cache of synthesized speech keyed on the text plus the
+         * LiveSpeakConfig fields that affect the audio (model, encoding,
+         * sampleRate, bitrate, container, speed), attached with
+         * SpeakRestClient::setSpeechCache() / SpeakWebsocketClient::setSpeechCache().
+         *
+         * Lookups check the byte-budgeted memory LRU first, then the disk tier.
+         * Safe to share between clients and threads. Every entry's content
+         * type is a MIME type: the REST response's Content-Type, or
+         * streamContentType() for WebSocket audio.
+         */
+        class DEEPGRAMPP_EXPORT SpeechCache
+        {
+        public:
+            explicit SpeechCache(SpeechCacheOptions options = {});
+            ~SpeechCache();
+
+            static std::string makeKey(const std::string &text, const LiveSpeakConfig &config, SpeechSource source);
+
+            /**
+             * MIME type of the WebSocket API's headerless audio for `config`,
+             * e.g. "audio/L16;rate=24000" or "audio/PCMU".
+             */
+            static std::string streamContentType(const LiveSpeakConfig &config);
+
+            /**
+             * @return The cached audio, or null on a miss. The audio stays valid
+             *         for as long as the returned pointer is held, even if the
+             *         entry is evicted or replaced meanwhile.
+             */
+            std::shared_ptr<const CachedSpeech> get(const std::string &key);
+            void put(const std::string &key, std::vector<std::uint8_t> audio, const std::string &contentType);
+
+            /**
+             * Drops the memory tier and deletes this cache's files from `directory`.
+             */
+            void clear();
+
+            std::size_t memoryBytes() const;
+
+        private:
+            std::unique_ptr<SpeechCacheState> _state;
+        };
+    }
+}
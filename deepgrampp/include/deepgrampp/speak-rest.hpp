@@ -2,6 +2,9 @@
 
 #include <deepgrampp_lib_export.h>
 #include "speak.hpp"
+#include "speak-cache.hpp"
+#include "rate-limiter.hpp"
+#include "retry-policy.hpp"
 #include "transport/http_transport.hpp"
 
 #include <memory>
@@ -30,6 +33,7 @@ namespace deepgram
             std::string contentType;
             std::optional<std::string> requestId;
             std::optional<std::string> modelName;
+            bool fromCache = false; // Served by the client's SpeechCache, no request was made
 
             explicit operator bool() const { return success; }
         };
@@ -64,6 +68,28 @@ namespace deepgram
              */
             SpeakRestResult speak(const std::string &text, const LiveSpeakConfig &config = {});
 
+            /**
+             * @brief Sets how failed requests are retried and/or hedged (see
+             * RetryPolicy). The default is a single attempt. Configure it before
+             * issuing requests; it isn't synchronized with calls in flight.
+             */
+            void setRetryPolicy(const RetryPolicy &policy);
+
+            /**
+             * @brief Shares a client-side rate limiter with other clients; every
+             * request attempt waits for a permit first. Pass null to detach. Same
+             * caveat as setRetryPolicy().
+             */
+            void setRateLimiter(std::shared_ptr<RateLimiter> rateLimiter);
+
+            /**
+             * @brief Serves speak() from `cache` when the same text was already
+             * synthesized with the same audio settings, and stores every
+             * successful result in it. Pass null to detach. Same caveat as
+             * setRetryPolicy().
+             */
+            void setSpeechCache(std::shared_ptr<SpeechCache> cache);
+
         private:
             std::unique_ptr<SpeakRestClientImpl> impl_;
         };
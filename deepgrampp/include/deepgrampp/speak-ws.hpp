@@ -2,7 +2,10 @@
 
 #include <deepgrampp_lib_export.h>
 #include "speak.hpp"
+#include "speak-cache.hpp"
+#include "rate-limiter.hpp"
 #include "transport/websocket_transport.hpp"
+#include <chrono>
 #include <functional>
 #include <memory>
 
@@ -53,6 +56,13 @@ namespace deepgram
              */
             void close();
 
+            /**
+             * Sets how long close() waits, after sending Close, for the server to
+             * deliver the remaining audio and close the socket. close() returns as
+             * soon as that happens. Default is 5 seconds.
+             */
+            void setCloseTimeout(std::chrono::milliseconds timeout);
+
             /**
              * @deprecated No longer required: audio/message delivery starts automatically
              * once connect() succeeds. Kept as a no-op for source compatibility.
@@ -107,13 +117,43 @@ namespace deepgram
             void setSpeechEndedCallback(SpeechEndedCallback callback);
 
             /**
-             * Sets the speech reception timeout.
-             * This timeout defines how long the client will wait for speech data before considering the connection lost
+             * The speech-ended callback fires as soon as the server has answered
+             * every Flush (its "Flushed" response follows the last audio frame)
+             * with no text sent since, or on "Cleared". This timeout is the
+             * fallback for speech that is never flushed: speech is considered
+             * ended once no audio arrived for `timeoutMs`.
              * @note this is not officially supported by Deepgram, but it is useful to detect speech generation end based on inactivity.
-             * @param timeoutMs Timeout in milliseconds. Default is 30000 ms (30 seconds)
+             * @param timeoutMs Timeout in milliseconds. Default is 500 ms.
              */
             void setSpeechReceptionTimeout(int timeoutMs);
 
+            /**
+             * Shares a client-side rate limiter with other clients.
+             * connect() then waits for a stream permit, held until the session closes.
+             * @param rateLimiter The limiter to attach, or null to detach.
+             */
+            void setRateLimiter(std::shared_ptr<RateLimiter> rateLimiter);
+
+            /**
+             * Decodes `mulaw`/`alaw` speech to linear16 (same sample rate)
+             * before it reaches the SpeechResultCallback, e.g. to mix it with
+             * other PCM. Has no effect on other encodings, or when a container
+             * is requested. The speech cache keeps the encoded audio.
+             * Off by default.
+             */
+            void setDecodeToLinear16(bool decode);
+
+            /**
+             * Attaches a speech cache shared with other clients.
+             * speak() of a cached text then replays its audio through the
+             * SpeechResultCallback straight away, without a network round trip.
+             * Texts that miss are synthesized normally and, once a Flush confirms
+             * their audio is complete, stored -- when they were the only text in
+             * flight, as in the usual speak() + sendFlushMessage() pattern.
+             * @param cache The cache to attach, or null to detach.
+             */
+            void setSpeechCache(std::shared_ptr<SpeechCache> cache);
+
         private:
             SpeechResultCallback _speechResultCallback;
             SpeechControlResponseCallback _speechControlResponseCallback;
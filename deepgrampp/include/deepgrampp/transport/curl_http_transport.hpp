@@ -2,8 +2,13 @@
 
 #include <deepgrampp_lib_export.h>
 #include "http_transport.hpp"
+#include "curl_share_context.hpp"
 
+#include <cstddef>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <vector>
 
 namespace deepgram
 {
@@ -13,6 +18,13 @@ namespace deepgram
          * HTTP transport backed by libcurl. Intended for Deepgram's REST endpoints
          * (pre-recorded transcription, one-shot text-to-speech); not used by the
          * WebSocket streaming clients.
+         *
+         * Safe to call send() from several threads at once: easy handles are kept
+         * in a small internal pool and reused across requests (each keeps its own
+         * connection cache), and a CurlShareContext can additionally be attached to
+         * share DNS/TLS-session caches with other transports. At most
+         * kMaxIdleHandles handles stay pooled; ones returned beyond that after a
+         * burst of concurrent requests are closed.
          */
         class DEEPGRAMPP_EXPORT CurlHttpTransport final : public IHttpTransport
         {
@@ -23,13 +35,26 @@ namespace deepgram
              *        mbedTLS backend has no visibility into the OS trust store (e.g.
              *        Android); leave empty elsewhere to keep using curl's platform
              *        default.
+             * @param shareContext Optional shared DNS/TLS-session cache,
+             *        e.g. CurlShareContext::processWide(). Null keeps every cache
+             *        private to this transport.
              */
-            explicit CurlHttpTransport(std::string caFilePath = {});
+            explicit CurlHttpTransport(std::string caFilePath = {},
+                                       std::shared_ptr<CurlShareContext> shareContext = nullptr);
+            ~CurlHttpTransport() override;
 
             HttpResponse send(const HttpRequest &request) override;
 
+            static constexpr std::size_t kMaxIdleHandles = 8;
+
         private:
+            void *acquireHandle();
+            void releaseHandle(void *handle);
+
             std::string _caFilePath;
+            std::shared_ptr<CurlShareContext> _shareContext;
+            std::mutex _poolMutex;
+            std::vector<void *> _idleHandles; // CURL *, kept opaque like CurlShareContext's
         };
 
     } // namespace transport
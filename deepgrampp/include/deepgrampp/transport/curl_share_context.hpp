@@ -0,0 +1,57 @@
+#pragma once
+
+#include <deepgrampp_lib_export.h>
+
+#include <memory>
+
+namespace deepgram
+{
+    namespace transport
+    {
+        struct CurlShareContextImpl;
+
+        /**
+         * Shared libcurl state (DNS cache and TLS session cache) backed by a
+         * `CURLSH` share handle, so that several CurlHttpTransport instances --
+         * typically one per worker thread -- reuse each other's lookups and
+         * resume each other's TLS sessions instead of each resolving and doing a
+         * full handshake on its own. Connections themselves stay with each
+         * transport's pooled handles: libcurl doesn't support sharing its
+         * connection cache between concurrent threads.
+         *
+         * Thread-safe: the share handle is guarded by one mutex per shared data
+         * kind, installed as curl's lock/unlock callbacks. Must outlive every
+         * transport it's attached to, which holding it by shared_ptr (as
+         * CurlHttpTransport does) guarantees.
+         */
+        class DEEPGRAMPP_EXPORT CurlShareContext
+        {
+        public:
+            /**
+             * Throws std::runtime_error if libcurl can't be initialized or the share
+             * handle can't be created.
+             */
+            CurlShareContext();
+            ~CurlShareContext();
+
+            CurlShareContext(const CurlShareContext &) = delete;
+            CurlShareContext &operator=(const CurlShareContext &) = delete;
+
+            /**
+             * A lazily created, process-wide instance for callers that don't need
+             * to scope sharing any narrower than "everything in this process".
+             */
+            static std::shared_ptr<CurlShareContext> processWide();
+
+            /**
+             * The underlying `CURLSH *`, typed as void* to keep curl's headers out
+             * of the public API.
+             */
+            void *nativeHandle() const;
+
+        private:
+            std::unique_ptr<CurlShareContextImpl> _impl;
+        };
+
+    } // namespace transport
+} // namespace deepgram
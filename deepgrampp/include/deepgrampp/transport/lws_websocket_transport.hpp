@@ -39,6 +39,10 @@ namespace deepgram
             void connect(const WebSocketConnectOptions &options) override;
             void sendText(const std::string &message) override;
             void sendBinary(const std::vector<std::uint8_t> &payload) override;
+            void sendText(const char *data, std::size_t size) override;
+            void sendBinary(const std::uint8_t *data, std::size_t size) override;
+            bool setBinaryFrameSource(BinaryFrameSource source) override;
+            void requestPull() override;
             void close() override;
             bool isOpen() const override;
 
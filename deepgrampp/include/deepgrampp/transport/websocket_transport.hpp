@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
 #include <functional>
 #include <map>
@@ -29,6 +30,7 @@ namespace deepgram
             using BinaryMessageHandler = std::function<void(const std::vector<std::uint8_t> &)>;
             using ErrorHandler = std::function<void(const std::string &)>;
             using CloseHandler = std::function<void()>;
+            using BinaryFrameSource = std::function<std::size_t(std::uint8_t *buffer, std::size_t capacity)>;
 
             virtual ~IWebSocketTransport() = default;
 
@@ -47,6 +49,46 @@ namespace deepgram
             virtual void sendText(const std::string &message) = 0;
             virtual void sendBinary(const std::vector<std::uint8_t> &payload) = 0;
 
+            /**
+             * Pointer/length overloads, so callers that serialize into their own
+             * reusable buffers don't need a std::string/std::vector per frame.
+             * The payload is copied before returning. The defaults forward to the
+             * container overloads; transports override them to skip that copy.
+             */
+            virtual void sendText(const char *data, std::size_t size)
+            {
+                sendText(std::string(data, size));
+            }
+            virtual void sendBinary(const std::uint8_t *data, std::size_t size)
+            {
+                sendBinary(std::vector<std::uint8_t>(data, data + size));
+            }
+
+            /**
+             * Pull-mode binary sending, for producers that must never block
+             * (e.g. audio-capture callbacks feeding a lock-free buffer). After
+             * requestPull(), the transport calls `source` from its I/O thread
+             * whenever the socket is writable; the source fills `buffer` with
+             * one binary frame of at most `capacity` bytes (at least 64 KiB)
+             * and returns its size, or 0 when it has nothing to send, which
+             * ends pulling until the next requestPull(). Frames queued with
+             * sendText()/sendBinary() go first.
+             *
+             * Passing null detaches the source; once that returns, the source
+             * is no longer running. Returns false if the transport doesn't
+             * support pulling; callers then push with sendBinary() instead.
+             */
+            virtual bool setBinaryFrameSource(BinaryFrameSource /*source*/)
+            {
+                return false;
+            }
+
+            /**
+             * Asks the I/O thread to call the frame source. Lock-free and cheap
+             * enough for a real-time thread.
+             */
+            virtual void requestPull() {}
+
             virtual void close() = 0;
             virtual bool isOpen() const = 0;
         };
@@ -0,0 +1,154 @@
+#pragma once
+
+#include <deepgrampp_lib_export.h>
+#include "listen.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace deepgram
+{
+    namespace listen
+    {
+        /**
+         * @brief Column-oriented (struct-of-arrays) view of one alternative's
+         * words, for analytics over long transcripts.
+         *
+         * Start/end times, confidences and speaker ids each live in their own
+         * contiguous array, so a scan over one field touches only that field's
+         * cache lines, and the aggregate queries below are branch-free loops
+         * the compiler can vectorize. Word texts are interned into a single
+         * string pool and stored as ids; repeated words cost four bytes each.
+         *
+         * Words are expected in chronological order (as Deepgram returns them);
+         * the time-range lookups binary-search the start/end columns.
+         */
+        class DEEPGRAMPP_EXPORT WordTimeline
+        {
+        public:
+            static constexpr std::int32_t kNoSpeaker = -1;
+            static constexpr std::uint32_t kNoText = 0xFFFFFFFFu;
+
+            /**
+             * Half-open range of word indices.
+             */
+            struct Range
+            {
+                std::size_t begin = 0;
+                std::size_t end = 0;
+
+                std::size_t size() const { return end - begin; }
+                bool empty() const { return begin == end; }
+            };
+
+            WordTimeline() = default;
+
+            /**
+             * Builds the timeline of one channel/alternative of a decoded response.
+             */
+            static WordTimeline fromResponse(const PrerecordedTranscriptionResponse &response,
+                                             std::size_t channel = 0, std::size_t alternative = 0);
+
+            /**
+             * Builds the timeline straight from the JSON text of a prerecorded
+             * response (`results.channels[]`) or a streaming Results message
+             * (`channel`), without a DOM or intermediate Word structs.
+             *
+             * @throws std::runtime_error on malformed JSON.
+             */
+            static WordTimeline parse(const std::string &json, std::size_t channel = 0, std::size_t alternative = 0);
+
+            /**
+             * Appends the words of `alt`, e.g. of successive final streaming results.
+             */
+            void append(const Alternative &alt);
+            void append(std::string_view word, double start, double end, float confidence,
+                        std::int32_t speaker = kNoSpeaker, std::string_view punctuatedWord = {});
+
+            void reserve(std::size_t words);
+            void clear();
+
+            std::size_t size() const { return _starts.size(); }
+            bool empty() const { return _starts.empty(); }
+            Range all() const { return Range{0, size()}; }
+
+            // Columns, indexed by word.
+            const std::vector<double> &starts() const { return _starts; }
+            const std::vector<double> &ends() const { return _ends; }
+            const std::vector<float> &confidences() const { return _confidences; }
+            const std::vector<std::int32_t> &speakers() const { return _speakers; }
+            const std::vector<std::uint32_t> &wordIds() const { return _wordIds; }
+            const std::vector<std::uint32_t> &punctuatedWordIds() const { return _punctuatedIds; }
+
+            /**
+             * Text of an interned id; empty for kNoText.
+             */
+            std::string_view text(std::uint32_t id) const;
+            std::string_view word(std::size_t index) const { return text(_wordIds[index]); }
+
+            /**
+             * The punctuated form of the word at `index`, or the bare word if
+             * the response had none.
+             */
+            std::string_view punctuatedWord(std::size_t index) const;
+
+            /**
+             * Id of `text` in the pool, or kNoText if no word has that text.
+             */
+            std::uint32_t find(std::string_view text) const;
+            std::size_t distinctTexts() const { return _textOffsets.size() - 1; }
+
+            /**
+             * Words overlapping the time span [from, to), in seconds.
+             */
+            Range between(double from, double to) const;
+
+            /**
+             * Indices of the words in `range` spoken by `speaker`.
+             */
+            std::vector<std::size_t> wordsOfSpeaker(std::int32_t speaker, Range range) const;
+            std::vector<std::size_t> wordsOfSpeaker(std::int32_t speaker) const { return wordsOfSpeaker(speaker, all()); }
+
+            /**
+             * Summed word durations (end - start) of `speaker` in `range`.
+             */
+            double speakingTime(std::int32_t speaker, Range range) const;
+            double speakingTime(std::int32_t speaker) const { return speakingTime(speaker, all()); }
+
+            /**
+             * Mean word confidence over `range`; 0 for an empty range.
+             */
+            double meanConfidence(Range range) const;
+
+            /**
+             * Number of words in `range` whose confidence is below `threshold`.
+             */
+            std::size_t countBelow(float threshold, Range range) const;
+
+            /**
+             * Words of `range` joined by single spaces, punctuated where available.
+             */
+            std::string joinedText(Range range, bool punctuated = true) const;
+
+        private:
+            std::uint32_t intern(std::string_view text);
+
+            std::vector<double> _starts;
+            std::vector<double> _ends;
+            std::vector<float> _confidences;
+            std::vector<std::int32_t> _speakers;
+            std::vector<std::uint32_t> _wordIds;
+            std::vector<std::uint32_t> _punctuatedIds;
+
+            // Interned texts: id i spans _pool[_textOffsets[i], _textOffsets[i + 1]).
+            std::string _pool;
+            std::vector<std::uint32_t> _textOffsets{0};
+            // Hash of the text -> id; collisions are resolved against the pool.
+            std::unordered_multimap<std::size_t, std::uint32_t> _textIndex;
+        };
+    }
+}
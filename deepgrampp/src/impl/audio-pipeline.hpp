@@ -0,0 +1,205 @@
+#pragma once
+
+#include "../../include/deepgrampp/audio/format.hpp"
+#include "../../include/deepgrampp/audio/g711.hpp"
+#include "../../include/deepgrampp/audio/pcm.hpp"
+#include "../../include/deepgrampp/audio/resampler.hpp"
+#include "../../include/deepgrampp/audio/stage.hpp"
+#include "../../include/deepgrampp/audio/vad.hpp"
+
+#include <spdlog/spdlog.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace deepgram
+{
+    /**
+     * The pre-send stages of a streaming session. Audio handed to
+     * streamAudio()/pushAudio() arrives in the input format and leaves in the
+     * wire format, i.e. what the connection's encoding/sample_rate/channels
+     * announced to the server.
+     *
+     * Not thread-safe: callers serialize process() and flush(), and hold
+     * that lock while they use the output. Output is written to two buffers
+     * used alternately, so the steady state doesn't allocate.
+     */
+    class AudioPipeline
+    {
+    public:
+        struct Output
+        {
+            const std::uint8_t *data;
+            std::size_t size;
+        };
+
+        /**
+         * Format of the audio the application sends. Unset, it's taken to be
+         * the wire format.
+         */
+        void setInputFormat(const audio::AudioFormat &format)
+        {
+            _inputFormat = format;
+            _hasInputFormat = true;
+        }
+
+        void add(std::shared_ptr<audio::IAudioStage> stage)
+        {
+            if (stage)
+            {
+                _added.push_back(std::move(stage));
+            }
+        }
+
+        /**
+         * A voice activity gate, run after the other stages but ahead of G.711
+         * encoding in the default chain. Null removes it.
+         */
+        void setGate(std::shared_ptr<audio::VoiceActivityGate> gate)
+        {
+            _gate = std::move(gate);
+        }
+
+        /**
+         * A compressing stage run last, after the format check: the wire
+         * format is then the PCM it takes rather than what goes out on the
+         * socket. Null removes it.
+         */
+        void setEncoder(std::shared_ptr<audio::IAudioStage> encoder)
+        {
+            _encoder = std::move(encoder);
+        }
+
+        /**
+         * Readies the stages for a new session. Without explicit stages, a
+         * PcmConverter is used whenever the input's sample format or channels
+         * differ from the wire's, followed by a Resampler when the rates do,
+         * and a G711Encoder when the wire is mulaw/alaw. Converting first
+         * means channels are mixed down before resampling.
+         * `described` is the input when no input format was set, if the
+         * connection options describe something other than `wire`.
+         * Returns the input format.
+         */
+        audio::AudioFormat configure(const audio::AudioFormat &wire, const audio::AudioFormat *described = nullptr)
+        {
+            const audio::AudioFormat input = _hasInputFormat ? _inputFormat : (described ? *described : wire);
+            _stages = _added;
+            if (_stages.empty() && input.linear())
+            {
+                // The linear PCM the later stages take: the wire format
+                // itself, or int16 for G.711 to compress.
+                audio::AudioFormat pcm = wire;
+                pcm.sampleFormat = wire.linear() ? wire.sampleFormat : audio::SampleFormat::Int16;
+                audio::AudioFormat resampled = input;
+                resampled.sampleRate = wire.sampleRate;
+                if (resampled != pcm)
+                {
+                    if (!_converter)
+                    {
+                        _converter = std::make_shared<audio::PcmConverter>();
+                    }
+                    _stages.push_back(_converter);
+                }
+                if (input.sampleRate != wire.sampleRate)
+                {
+                    if (!_resampler)
+                    {
+                        _resampler = std::make_shared<audio::Resampler>();
+                    }
+                    _stages.push_back(_resampler);
+                }
+                if (wire.sampleFormat == audio::SampleFormat::Mulaw || wire.sampleFormat == audio::SampleFormat::Alaw)
+                {
+                    if (!_g711)
+                    {
+                        _g711 = std::make_shared<audio::G711Encoder>();
+                    }
+                    _stages.push_back(_g711);
+                }
+            }
+            if (_gate)
+            {
+                const bool encodes = !_stages.empty() && _stages.back() == _g711;
+                _stages.insert(encodes ? _stages.end() - 1 : _stages.end(), _gate);
+            }
+
+            audio::AudioFormat format = input;
+            for (const auto &stage : _stages)
+            {
+                format = stage->configure(format, wire);
+            }
+            if (format != wire && wire.sampleFormat != audio::SampleFormat::Encoded)
+            {
+                spdlog::warn("audio stages produce {} but the connection expects {}", audio::toString(format), audio::toString(wire));
+            }
+            if (_encoder)
+            {
+                _encoder->configure(format, wire);
+                _stages.push_back(_encoder);
+            }
+            return input;
+        }
+
+        bool empty() const
+        {
+            return _stages.empty();
+        }
+
+        /**
+         * Runs a chunk through every stage. The output stays valid until the
+         * next call, and may be empty while stages hold audio back.
+         */
+        Output process(const std::uint8_t *data, std::size_t size)
+        {
+            return run(0, data, size);
+        }
+
+        /**
+         * End of stream: drains what the stages still hold, each stage's tail
+         * passing through the stages after it.
+         */
+        Output flush()
+        {
+            _flushed.clear();
+            for (std::size_t i = 0; i < _stages.size(); ++i)
+            {
+                _buffers[0].clear();
+                _stages[i]->flush(_buffers[0]);
+                const Output out = run(i + 1, _buffers[0].data(), _buffers[0].size());
+                _flushed.insert(_flushed.end(), out.data, out.data + out.size);
+            }
+            return {_flushed.data(), _flushed.size()};
+        }
+
+    private:
+        // Stage k writes to _buffers[(k - first + 1) % 2], so the first stage
+        // never writes over its input when that is _buffers[0].
+        Output run(std::size_t first, const std::uint8_t *data, std::size_t size)
+        {
+            Output out{data, size};
+            for (std::size_t k = first; k < _stages.size(); ++k)
+            {
+                std::vector<std::uint8_t> &buffer = _buffers[(k - first + 1) % 2];
+                buffer.clear();
+                _stages[k]->process(out.data, out.size, buffer);
+                out = {buffer.data(), buffer.size()};
+            }
+            return out;
+        }
+
+        audio::AudioFormat _inputFormat;
+        bool _hasInputFormat = false;
+        std::vector<std::shared_ptr<audio::IAudioStage>> _added;
+        std::vector<std::shared_ptr<audio::IAudioStage>> _stages;
+        std::shared_ptr<audio::PcmConverter> _converter;
+        std::shared_ptr<audio::Resampler> _resampler;
+        std::shared_ptr<audio::G711Encoder> _g711;
+        std::shared_ptr<audio::VoiceActivityGate> _gate;
+        std::shared_ptr<audio::IAudioStage> _encoder;
+        std::vector<std::uint8_t> _buffers[2];
+        std::vector<std::uint8_t> _flushed;
+    };
+}
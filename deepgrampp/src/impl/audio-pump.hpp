@@ -0,0 +1,286 @@
+#pragma once
+
+#include "../../include/deepgrampp/audio/push.hpp"
+#include "../../include/deepgrampp/transport/websocket_transport.hpp"
+#include "spsc-ring.hpp"
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace deepgram
+{
+    /**
+     * Backs pushAudio(): the caller's thread (typically an audio-capture
+     * callback) writes into an SpscByteRing and the transport drains it in
+     * fixed-size frames.
+     *
+     * Transports that support pull-mode sending (IWebSocketTransport::
+     * setBinaryFrameSource) read frames straight from the ring on their I/O
+     * thread. For the others a sender thread drains the ring into
+     * sendBinary(). Either way push() never locks or allocates; it wakes the
+     * sender at most once per frame.
+     */
+    class AudioPump
+    {
+    public:
+        ~AudioPump()
+        {
+            stop();
+        }
+
+        /**
+         * Allocates the ring and attaches to `transport`. `bytesPerSecond` is
+         * 0 when the encoding's byte rate is unknown.
+         */
+        void start(std::shared_ptr<transport::IWebSocketTransport> transport, const audio::PushOptions &options,
+                   std::size_t bytesPerSecond, std::size_t bytesPerSampleFrame)
+        {
+            stop();
+
+            std::size_t frameBytes = options.fallbackFrameBytes;
+            std::size_t bufferBytes = options.bufferBytes;
+            if (bytesPerSecond > 0 && bytesPerSampleFrame > 0)
+            {
+                const auto frameDuration = std::max(options.frameDuration, std::chrono::milliseconds(1));
+                frameBytes = bytesPerSecond * static_cast<std::size_t>(frameDuration.count()) / 1000;
+                frameBytes = std::max(bytesPerSampleFrame, frameBytes / bytesPerSampleFrame * bytesPerSampleFrame);
+                if (bufferBytes == 0)
+                {
+                    bufferBytes = 2 * bytesPerSecond;
+                }
+            }
+            frameBytes = std::min(std::max<std::size_t>(frameBytes, 1), kMaxFrameBytes);
+            if (bufferBytes == 0)
+            {
+                bufferBytes = 256 * 1024;
+            }
+
+            _ring.reset(std::max(bufferBytes, frameBytes));
+            _frameBytes = frameBytes;
+            _flushing.store(false);
+            _wakePending.store(false);
+            _droppedBytes.store(0);
+            _transport = std::move(transport);
+            _started = true;
+
+            _pulled = _transport->setBinaryFrameSource([this](std::uint8_t *buffer, std::size_t capacity)
+                                                       { return pull(buffer, capacity); });
+            if (!_pulled)
+            {
+                _running.store(true);
+                _sender = std::thread([this]()
+                                      { senderLoop(); });
+            }
+            _active.store(true, std::memory_order_release);
+        }
+
+        /**
+         * Producer side: buffers `data` for sending. Returns false, dropping
+         * the whole chunk, when not started or the ring is full.
+         */
+        bool push(const std::uint8_t *data, std::size_t size)
+        {
+            if (!_active.load(std::memory_order_acquire))
+            {
+                return false;
+            }
+            if (!_ring.write(data, size))
+            {
+                _droppedBytes.fetch_add(size, std::memory_order_relaxed);
+                return false;
+            }
+            if (_ring.size() >= _frameBytes && !_wakePending.exchange(true))
+            {
+                wake();
+            }
+            return true;
+        }
+
+        /**
+         * Counts a chunk the producer dropped before it got to push().
+         */
+        void drop(std::size_t size)
+        {
+            _droppedBytes.fetch_add(size, std::memory_order_relaxed);
+        }
+
+        /**
+         * Blocks until everything pushed so far, including a trailing partial
+         * frame, has been handed to the transport, so a control message sent
+         * next can't overtake it. Gives up after `timeout`.
+         */
+        bool flush(std::chrono::milliseconds timeout = std::chrono::seconds(2))
+        {
+            if (!_started || _ring.size() == 0)
+            {
+                return true;
+            }
+            _flushing.store(true);
+            _wakePending.store(true);
+            wake();
+            const auto deadline = std::chrono::steady_clock::now() + timeout;
+            while (_ring.size() > 0 && _transport->isOpen() && std::chrono::steady_clock::now() < deadline)
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+            _flushing.store(false);
+            return _ring.size() == 0;
+        }
+
+        /**
+         * Flushes what's left and detaches from the transport. Pushes made
+         * after this returns are rejected. The transport itself is kept until
+         * the next start(), as a push that raced with stop() may still wake it.
+         */
+        void stop()
+        {
+            if (!_started)
+            {
+                return;
+            }
+            _active.store(false, std::memory_order_release);
+            if (_transport->isOpen() && !flush())
+            {
+                spdlog::warn("pushed audio not fully sent before close, {} bytes left", _ring.size());
+            }
+            if (_pulled)
+            {
+                _transport->setBinaryFrameSource(nullptr);
+            }
+            else
+            {
+                _running.store(false);
+                _senderCv.notify_one();
+                if (_sender.joinable())
+                {
+                    _sender.join();
+                }
+            }
+            const std::size_t dropped = _droppedBytes.load();
+            if (dropped > 0)
+            {
+                spdlog::warn("dropped {} bytes of pushed audio, the send buffer was full or the stages were draining", dropped);
+            }
+            _started = false;
+        }
+
+        std::size_t droppedBytes() const
+        {
+            return _droppedBytes.load(std::memory_order_relaxed);
+        }
+
+        /**
+         * steady_clock ticks at which the last frame was handed to the
+         * transport, or 0 if none was.
+         */
+        std::chrono::steady_clock::rep lastSendTime() const
+        {
+            return _lastSendTime.load(std::memory_order_relaxed);
+        }
+
+    private:
+        // Upper bound of one pulled frame, so transports can size their buffers.
+        static constexpr std::size_t kMaxFrameBytes = 64 * 1024;
+
+        void markSent()
+        {
+            _lastSendTime.store(std::chrono::steady_clock::now().time_since_epoch().count(), std::memory_order_relaxed);
+        }
+
+        void wake()
+        {
+            if (_pulled)
+            {
+                _transport->requestPull();
+            }
+            else
+            {
+                _senderCv.notify_one();
+            }
+        }
+
+        // Size of the next frame to send, or 0 if a full one isn't buffered yet.
+        std::size_t nextFrameBytes(std::size_t capacity)
+        {
+            // Cleared before looking at the ring, so a push racing with this
+            // call sees the flag down and wakes the sender again.
+            _wakePending.store(false);
+            const std::size_t available = _ring.size();
+            const std::size_t wanted = std::min(_frameBytes, capacity);
+            if (available >= wanted)
+            {
+                return wanted;
+            }
+            return _flushing.load() ? available : 0;
+        }
+
+        // Runs on the transport's I/O thread, which writes the frame before
+        // releasing its send lock.
+        std::size_t pull(std::uint8_t *buffer, std::size_t capacity)
+        {
+            const std::size_t size = _ring.peek(buffer, nextFrameBytes(capacity));
+            _ring.consume(size);
+            if (size > 0)
+            {
+                markSent();
+            }
+            return size;
+        }
+
+        void senderLoop()
+        {
+            std::vector<std::uint8_t> frame(_frameBytes);
+            while (_running.load())
+            {
+                {
+                    // The timeout covers a notify that lands between the
+                    // predicate check and the wait; push() doesn't take the lock.
+                    std::unique_lock<std::mutex> lk(_senderMutex);
+                    _senderCv.wait_for(lk, std::chrono::milliseconds(10));
+                }
+                std::size_t size;
+                while ((size = _ring.peek(frame.data(), nextFrameBytes(frame.size()))) > 0)
+                {
+                    try
+                    {
+                        _transport->sendBinary(frame.data(), size);
+                        markSent();
+                    }
+                    catch (const std::exception &e)
+                    {
+                        spdlog::error("Send chunk error: {}", e.what());
+                    }
+                    // Consumed only once sent, so flush() sees an empty ring
+                    // only when nothing is still in flight.
+                    _ring.consume(size);
+                }
+            }
+        }
+
+        SpscByteRing _ring;
+        std::size_t _frameBytes = 0;
+        std::shared_ptr<transport::IWebSocketTransport> _transport;
+        bool _pulled = false;
+        bool _started = false;
+
+        std::atomic<bool> _active{false};
+        std::atomic<bool> _flushing{false};
+        std::atomic<bool> _wakePending{false};
+        std::atomic<std::size_t> _droppedBytes{0};
+        std::atomic<std::chrono::steady_clock::rep> _lastSendTime{0};
+
+        std::atomic<bool> _running{false};
+        std::thread _sender;
+        std::mutex _senderMutex;
+        std::condition_variable _senderCv;
+    };
+}
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+
+namespace deepgram
+{
+    /**
+     * Lets close() wait for the server to finish a session rather than
+     * sleeping a fixed time. arm() when the session opens; signal() when its
+     * last expected message or the close frame arrives; close() then wait()s
+     * for that, up to a deadline.
+     */
+    class CloseLatch
+    {
+    public:
+        static constexpr std::chrono::milliseconds kDefaultTimeout{5000};
+
+        void arm()
+        {
+            std::lock_guard<std::mutex> lk(_mutex);
+            _signaled = false;
+        }
+
+        void signal()
+        {
+            {
+                std::lock_guard<std::mutex> lk(_mutex);
+                _signaled = true;
+            }
+            _cv.notify_all();
+        }
+
+        /**
+         * Returns false if `timeout` passed without a signal().
+         */
+        bool wait(std::chrono::milliseconds timeout)
+        {
+            std::unique_lock<std::mutex> lk(_mutex);
+            return _cv.wait_for(lk, timeout, [this]()
+                                { return _signaled; });
+        }
+
+    private:
+        std::mutex _mutex;
+        std::condition_variable _cv;
+        bool _signaled = false;
+    };
+}
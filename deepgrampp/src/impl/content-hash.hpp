@@ -0,0 +1,174 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+namespace deepgram
+{
+    /**
+     * Incremental XXH64 hash of a byte stream, fed chunk by chunk as the data
+     * is read. The main loop keeps four independent 64-bit lanes, so the
+     * compiler can pipeline (and, where the target allows, vectorize) them;
+     * it runs at memory bandwidth on any recent CPU. Not cryptographic: good
+     * for content addressing, not for anything adversarial.
+     */
+    class ContentHasher
+    {
+    public:
+        explicit ContentHasher(std::uint64_t seed = 0)
+            : _seed(seed)
+        {
+            _lanes[0] = seed + kPrime1 + kPrime2;
+            _lanes[1] = seed + kPrime2;
+            _lanes[2] = seed;
+            _lanes[3] = seed - kPrime1;
+        }
+
+        void update(const void *data, std::size_t size)
+        {
+            const auto *p = static_cast<const std::uint8_t *>(data);
+            _totalLength += size;
+
+            if (_bufferedSize + size < sizeof(_buffer))
+            {
+                std::memcpy(_buffer + _bufferedSize, p, size);
+                _bufferedSize += size;
+                return;
+            }
+            if (_bufferedSize > 0)
+            {
+                const std::size_t fill = sizeof(_buffer) - _bufferedSize;
+                std::memcpy(_buffer + _bufferedSize, p, fill);
+                consumeStripe(_buffer);
+                p += fill;
+                size -= fill;
+                _bufferedSize = 0;
+            }
+            while (size >= sizeof(_buffer))
+            {
+                consumeStripe(p);
+                p += sizeof(_buffer);
+                size -= sizeof(_buffer);
+            }
+            std::memcpy(_buffer, p, size);
+            _bufferedSize = size;
+        }
+
+        /**
+         * Hash of everything fed so far; doesn't change the hasher's state.
+         */
+        std::uint64_t digest() const
+        {
+            std::uint64_t h;
+            if (_totalLength >= sizeof(_buffer))
+            {
+                h = rotl(_lanes[0], 1) + rotl(_lanes[1], 7) + rotl(_lanes[2], 12) + rotl(_lanes[3], 18);
+                for (const std::uint64_t lane : _lanes)
+                {
+                    h = (h ^ round(0, lane)) * kPrime1 + kPrime4;
+                }
+            }
+            else
+            {
+                h = _seed + kPrime5;
+            }
+            h += _totalLength;
+
+            const std::uint8_t *p = _buffer;
+            std::size_t remaining = _bufferedSize;
+            for (; remaining >= 8; p += 8, remaining -= 8)
+            {
+                h = rotl(h ^ round(0, read64(p)), 27) * kPrime1 + kPrime4;
+            }
+            if (remaining >= 4)
+            {
+                h = rotl(h ^ (static_cast<std::uint64_t>(read32(p)) * kPrime1), 23) * kPrime2 + kPrime3;
+                p += 4;
+                remaining -= 4;
+            }
+            for (; remaining > 0; ++p, --remaining)
+            {
+                h = rotl(h ^ (*p * kPrime5), 11) * kPrime1;
+            }
+
+            h ^= h >> 33;
+            h *= kPrime2;
+            h ^= h >> 29;
+            h *= kPrime3;
+            h ^= h >> 32;
+            return h;
+        }
+
+        std::uint64_t totalLength() const
+        {
+            return _totalLength;
+        }
+
+        static std::uint64_t hash(const void *data, std::size_t size, std::uint64_t seed = 0)
+        {
+            ContentHasher hasher(seed);
+            hasher.update(data, size);
+            return hasher.digest();
+        }
+
+        static std::string toHex(std::uint64_t value)
+        {
+            static const char digits[] = "0123456789abcdef";
+            std::string hex(16, '0');
+            for (int i = 15; i >= 0; --i, value >>= 4)
+            {
+                hex[i] = digits[value & 0xF];
+            }
+            return hex;
+        }
+
+    private:
+        static constexpr std::uint64_t kPrime1 = 0x9E3779B185EBCA87ULL;
+        static constexpr std::uint64_t kPrime2 = 0xC2B2AE3D27D4EB4FULL;
+        static constexpr std::uint64_t kPrime3 = 0x165667B19E3779F9ULL;
+        static constexpr std::uint64_t kPrime4 = 0x85EBCA77C2B2AE63ULL;
+        static constexpr std::uint64_t kPrime5 = 0x27D4EB2F165667C5ULL;
+
+        static std::uint64_t rotl(std::uint64_t x, int r)
+        {
+            return (x << r) | (x >> (64 - r));
+        }
+
+        static std::uint64_t read64(const std::uint8_t *p)
+        {
+            std::uint64_t v;
+            std::memcpy(&v, p, sizeof(v));
+            return v; // XXH64 is defined on little-endian words; all supported targets are LE
+        }
+
+        static std::uint32_t read32(const std::uint8_t *p)
+        {
+            std::uint32_t v;
+            std::memcpy(&v, p, sizeof(v));
+            return v;
+        }
+
+        static std::uint64_t round(std::uint64_t acc, std::uint64_t input)
+        {
+            acc += input * kPrime2;
+            acc = rotl(acc, 31);
+            return acc * kPrime1;
+        }
+
+        void consumeStripe(const std::uint8_t *p)
+        {
+            _lanes[0] = round(_lanes[0], read64(p));
+            _lanes[1] = round(_lanes[1], read64(p + 8));
+            _lanes[2] = round(_lanes[2], read64(p + 16));
+            _lanes[3] = round(_lanes[3], read64(p + 24));
+        }
+
+        std::uint64_t _seed;
+        std::uint64_t _lanes[4];
+        std::uint8_t _buffer[32];
+        std::size_t _bufferedSize = 0;
+        std::uint64_t _totalLength = 0;
+    };
+}
@@ -0,0 +1,126 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace deepgram
+{
+    /**
+     * Appends `text` to `out` escaped as the contents of a JSON string, in a
+     * single pass: runs of plain characters are appended in bulk, `"`, `\` and
+     * control characters are escaped, and valid UTF-8 is copied as-is. Invalid
+     * UTF-8 is replaced by U+FFFD, where nlohmann's dump() would throw.
+     */
+    inline void appendJsonEscaped(std::string &out, std::string_view text)
+    {
+        static constexpr char kHex[] = "0123456789abcdef";
+        const auto *bytes = reinterpret_cast<const std::uint8_t *>(text.data());
+        const std::size_t n = text.size();
+        std::size_t runStart = 0;
+        std::size_t i = 0;
+        const auto flush = [&]()
+        {
+            out.append(text.data() + runStart, i - runStart);
+        };
+
+        while (i < n)
+        {
+            const std::uint8_t c = bytes[i];
+            if (c >= 0x20 && c != '"' && c != '\\' && c < 0x80)
+            {
+                ++i;
+                continue;
+            }
+            if (c >= 0x80)
+            {
+                // Length of the sequence from its lead byte, then verify the
+                // continuation bytes and reject overlongs/surrogates/> U+10FFFF.
+                std::size_t length = 0;
+                std::uint8_t lo = 0x80, hi = 0xBF;
+                if (c >= 0xC2 && c <= 0xDF)
+                {
+                    length = 2;
+                }
+                else if (c >= 0xE0 && c <= 0xEF)
+                {
+                    length = 3;
+                    lo = c == 0xE0 ? 0xA0 : 0x80;
+                    hi = c == 0xED ? 0x9F : 0xBF;
+                }
+                else if (c >= 0xF0 && c <= 0xF4)
+                {
+                    length = 4;
+                    lo = c == 0xF0 ? 0x90 : 0x80;
+                    hi = c == 0xF4 ? 0x8F : 0xBF;
+                }
+                std::size_t matched = 1;
+                if (length > 0 && i + 1 < n && bytes[i + 1] >= lo && bytes[i + 1] <= hi)
+                {
+                    ++matched;
+                    while (matched < length && i + matched < n && (bytes[i + matched] & 0xC0) == 0x80)
+                    {
+                        ++matched;
+                    }
+                }
+                if (matched == length)
+                {
+                    i += length;
+                    continue;
+                }
+                // One replacement per maximal invalid subpart, as Unicode recommends.
+                flush();
+                out += "\xEF\xBF\xBD";
+                i += matched;
+                runStart = i;
+                continue;
+            }
+
+            flush();
+            switch (c)
+            {
+            case '"':
+                out += "\\\"";
+                break;
+            case '\\':
+                out += "\\\\";
+                break;
+            case '\b':
+                out += "\\b";
+                break;
+            case '\f':
+                out += "\\f";
+                break;
+            case '\n':
+                out += "\\n";
+                break;
+            case '\r':
+                out += "\\r";
+                break;
+            case '\t':
+                out += "\\t";
+                break;
+            default:
+            {
+                const char escape[6] = {'\\', 'u', '0', '0', kHex[c >> 4], kHex[c & 0xF]};
+                out.append(escape, sizeof(escape));
+                break;
+            }
+            }
+            runStart = ++i;
+        }
+        flush();
+    }
+
+    /**
+     * Replaces the contents of `out` with `{"type":"Speak","text":"<text>"}`,
+     * reusing its capacity.
+     */
+    inline void writeSpeakMessage(std::string &out, std::string_view text)
+    {
+        out.assign(R"({"type":"Speak","text":")");
+        appendJsonEscaped(out, text);
+        out += "\"}";
+    }
+}
@@ -0,0 +1,68 @@
+#pragma once
+
+#include "../../include/deepgrampp/listen.hpp"
+
+#include <nlohmann/json.hpp>
+
+#include <string>
+
+namespace deepgram
+{
+    namespace listen
+    {
+        /**
+         * Parses a transcription response into a DOM, dropping the subtrees
+         * `profile` doesn't need while parsing: discarded values are tokenized
+         * but never materialized, so a TranscriptOnly parse of a message with
+         * twenty words allocates no Word-related nodes at all.
+         */
+        inline nlohmann::json parseWithProfile(const std::string &text, DecodeProfile profile)
+        {
+            if (profile == DecodeProfile::Full)
+            {
+                return nlohmann::json::parse(text);
+            }
+            return nlohmann::json::parse(text, [profile](int, nlohmann::json::parse_event_t event, nlohmann::json &parsed)
+                                         {
+                if (event != nlohmann::json::parse_event_t::key)
+                {
+                    return true;
+                }
+                const auto &key = parsed.get_ref<const std::string &>();
+                if (key == "words")
+                {
+                    return profile != DecodeProfile::TranscriptOnly;
+                }
+                return key != "punctuated_word" && key != "speaker" && key != "speaker_confidence"; });
+        }
+
+        /**
+         * Strips what `profile` excludes from an already decoded response, for
+         * paths that had to decode more than the caller asked for.
+         */
+        inline void applyDecodeProfile(PrerecordedTranscriptionResponse &response, DecodeProfile profile)
+        {
+            if (profile == DecodeProfile::Full)
+            {
+                return;
+            }
+            for (auto &channel : response.channels)
+            {
+                for (auto &alt : channel.alternatives)
+                {
+                    if (profile == DecodeProfile::TranscriptOnly)
+                    {
+                        alt.words.clear();
+                        continue;
+                    }
+                    for (auto &word : alt.words)
+                    {
+                        word.punctuated_word.reset();
+                        word.speaker.reset();
+                        word.speakerConfidence.reset();
+                    }
+                }
+            }
+        }
+    }
+}
@@ -1,7 +1,13 @@
 #pragma once
 
 #include "../../include/deepgrampp/listen-flux.hpp"
+#include "../../include/deepgrampp/audio/pacing.hpp"
 #include "../../include/deepgrampp/transport/lws_websocket_transport.hpp"
+#include "audio-pipeline.hpp"
+#include "audio-pump.hpp"
+#include "close-latch.hpp"
+#include "message-router.hpp"
+#include "stream-slot.hpp"
 
 #include <spdlog/spdlog.h>
 
@@ -9,6 +15,7 @@
 #include <chrono>
 #include <functional>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <thread>
 
@@ -47,6 +54,40 @@ namespace deepgram
                 {
                     _wsTransport->setOnTextMessage(std::move(onMessage));
                     _wsTransport->setOnError(std::move(onError));
+                    _wsTransport->setOnClose([this]()
+                                             {
+                        _streamSlot.release();
+                        _closeLatch.signal(); });
+                }
+
+                void setCloseTimeout(std::chrono::milliseconds timeout)
+                {
+                    _closeTimeout = timeout;
+                }
+
+                void setRateLimiter(std::shared_ptr<RateLimiter> rateLimiter)
+                {
+                    _streamSlot.setRateLimiter(std::move(rateLimiter));
+                }
+
+                MessageRouter &router()
+                {
+                    return _router;
+                }
+
+                void setPushOptions(const audio::PushOptions &options)
+                {
+                    _pushOptions = options;
+                }
+
+                void setAudioInputFormat(const audio::AudioFormat &format)
+                {
+                    _pipeline.setInputFormat(format);
+                }
+
+                void addAudioStage(std::shared_ptr<audio::IAudioStage> stage)
+                {
+                    _pipeline.add(std::move(stage));
                 }
 
                 bool connect(const FluxQueryParams &params)
@@ -56,6 +97,7 @@ namespace deepgram
                         spdlog::warn("Already connected to Deepgram.");
                         return true;
                     }
+                    RateLimiter::Permit permit = _streamSlot.acquire();
                     try
                     {
                         transport::WebSocketConnectOptions wsOptions;
@@ -64,7 +106,18 @@ namespace deepgram
                         wsOptions.headers["User-Agent"] = "DeepgramCppClient/1.0";
 
                         spdlog::debug("Connecting to {} ...", wsOptions.url);
+                        _closeLatch.arm();
                         _wsTransport->connect(wsOptions);
+                        _streamSlot.hold(std::move(permit));
+                        _encoding = params.encoding;
+                        _sampleRate = params.sample_rate;
+                        {
+                            // Flux takes mono audio only.
+                            std::lock_guard<std::mutex> lk(_pipelineMutex);
+                            _inputFormat = _pipeline.configure(audio::wireFormat(_encoding, _sampleRate, 1));
+                        }
+                        const std::size_t frameBytes = audio::bytesPerSampleFrame(_encoding, 1);
+                        _audioPump.start(_wsTransport, _pushOptions, frameBytes * static_cast<std::size_t>(std::max(_sampleRate, 0)), frameBytes);
                         spdlog::debug("WebSocket connected successfully!");
                         return true;
                     }
@@ -102,31 +155,82 @@ namespace deepgram
                     return true;
                 }
 
-                bool sendAudioChunk(const uint8_t *data, size_t size)
+                bool streamAudioPaced(const std::vector<uint8_t> &audioData, const audio::PacingOptions &pacing)
                 {
                     if (!_wsTransport->isOpen())
                     {
                         spdlog::error("Not connected to Deepgram.");
                         return false;
                     }
-                    try
+                    // Paced at the rate of the audio as handed in, before any stage.
+                    std::size_t frameBytes = _inputFormat.bytesPerFrame();
+                    std::size_t bytesPerSecond = _inputFormat.bytesPerSecond();
+                    if (frameBytes == 0)
                     {
-                        _wsTransport->sendBinary(std::vector<uint8_t>(data, data + size));
-                        return true;
+                        frameBytes = audio::bytesPerSampleFrame(_encoding, 1);
+                        bytesPerSecond = frameBytes * static_cast<std::size_t>(std::max(_sampleRate, 0));
                     }
-                    catch (const std::exception &e)
+                    if (bytesPerSecond == 0)
                     {
-                        spdlog::error("Send chunk error: {}", e.what());
+                        spdlog::error("can't pace {} audio: its byte rate can't be derived from the connection options", _encoding);
                         return false;
                     }
+                    return audio::streamPaced(audioData.data(), audioData.size(), bytesPerSecond,
+                                              frameBytes, pacing, [this](const uint8_t *data, std::size_t size)
+                                              { return sendAudioChunk(data, size); });
                 }
 
-                void sendCloseStream()
+                bool pushAudio(const uint8_t *data, size_t size)
+                {
+                    if (_pipeline.empty())
+                    {
+                        return _audioPump.push(data, size);
+                    }
+                    // Stages run on the producer's thread; the sender only moves
+                    // wire-format bytes. While close drains them on another
+                    // thread the chunk is dropped rather than waited on.
+                    std::unique_lock<std::mutex> lk(_pipelineMutex, std::try_to_lock);
+                    if (!lk.owns_lock())
+                    {
+                        _audioPump.drop(size);
+                        return false;
+                    }
+                    const AudioPipeline::Output out = _pipeline.process(data, size);
+                    return out.size == 0 || _audioPump.push(out.data, out.size);
+                }
+
+                std::size_t droppedAudioBytes() const
+                {
+                    return _audioPump.droppedBytes();
+                }
+
+                bool sendAudioChunk(const uint8_t *data, size_t size)
+                {
+                    if (_pipeline.empty())
+                    {
+                        return sendWire(data, size);
+                    }
+                    std::lock_guard<std::mutex> lk(_pipelineMutex);
+                    const AudioPipeline::Output out = _pipeline.process(data, size);
+                    return out.size == 0 || sendWire(out.data, out.size);
+                }
+
+                bool sendCloseStream()
                 {
                     if (!_wsTransport->isOpen())
                     {
                         spdlog::warn("WebSocket is not connected.");
-                        return;
+                        return false;
+                    }
+                    _audioPump.flush();
+                    if (!_pipeline.empty())
+                    {
+                        std::lock_guard<std::mutex> lk(_pipelineMutex);
+                        const AudioPipeline::Output tail = _pipeline.flush();
+                        if (tail.size > 0)
+                        {
+                            sendWire(tail.data, tail.size);
+                        }
                     }
                     try
                     {
@@ -134,33 +238,70 @@ namespace deepgram
                         jsonPayload["type"] = "CloseStream";
                         _wsTransport->sendText(jsonPayload.dump());
                         spdlog::debug("Sent close stream message.");
+                        return true;
                     }
                     catch (const std::exception &e)
                     {
                         spdlog::error("Error in sendCloseStream: {}", e.what());
+                        return false;
                     }
                 }
 
                 void close()
                 {
+                    _audioPump.stop();
                     if (!_wsTransport->isOpen())
                     {
                         return;
                     }
                     spdlog::debug("Closing connection...");
 
-                    sendCloseStream();
-                    // Wait a moment for final messages
-                    std::this_thread::sleep_for(std::chrono::milliseconds(500));
+                    // The server closes the socket once its last TurnInfo is out.
+                    if (sendCloseStream() && !_closeLatch.wait(_closeTimeout))
+                    {
+                        spdlog::warn("server didn't close within {} ms of CloseStream, closing anyway", _closeTimeout.count());
+                    }
 
                     _wsTransport->close();
+                    _streamSlot.release();
                     spdlog::debug("Connection closed.");
                 }
 
             private:
+                // Sends audio already in the wire format.
+                bool sendWire(const uint8_t *data, size_t size)
+                {
+                    if (!_wsTransport->isOpen())
+                    {
+                        spdlog::error("Not connected to Deepgram.");
+                        return false;
+                    }
+                    try
+                    {
+                        _wsTransport->sendBinary(data, size);
+                        return true;
+                    }
+                    catch (const std::exception &e)
+                    {
+                        spdlog::error("Send chunk error: {}", e.what());
+                        return false;
+                    }
+                }
+
                 std::string _host;
                 std::string _apiKey;
                 std::shared_ptr<transport::IWebSocketTransport> _wsTransport;
+                StreamSlot _streamSlot;
+                MessageRouter _router;
+                std::string _encoding;
+                int _sampleRate = 0;
+                AudioPipeline _pipeline;
+                std::mutex _pipelineMutex; // serializes the sending thread with close
+                audio::AudioFormat _inputFormat;
+                audio::PushOptions _pushOptions;
+                AudioPump _audioPump;
+                CloseLatch _closeLatch;
+                std::chrono::milliseconds _closeTimeout{CloseLatch::kDefaultTimeout};
             };
         }
     }
@@ -2,14 +2,22 @@
 
 #include "../../include/deepgrampp/listen-rest.hpp"
 #include "../../include/deepgrampp/transport/curl_http_transport.hpp"
+#include "content-hash.hpp"
+#include "listen-decode.hpp"
+#include "listen-segmentation.hpp"
+#include "retrying-http-sender.hpp"
 
 #include <nlohmann/json.hpp>
 #include <spdlog/spdlog.h>
 
+#include <algorithm>
+#include <atomic>
 #include <fstream>
 #include <memory>
 #include <stdexcept>
 #include <string>
+#include <thread>
+#include <vector>
 
 namespace deepgram
 {
@@ -23,11 +31,31 @@ namespace deepgram
                                   std::shared_ptr<transport::IHttpTransport> httpTransport,
                                   const std::string &caFilePath = {})
                 : _host(host), _apiKey(apiKey),
-                  _httpTransport(httpTransport ? std::move(httpTransport)
-                                                : std::make_shared<transport::CurlHttpTransport>(caFilePath))
+                  _httpSender(httpTransport ? std::move(httpTransport)
+                                             : std::make_shared<transport::CurlHttpTransport>(caFilePath))
             {
             }
 
+            void setRetryPolicy(const RetryPolicy &policy)
+            {
+                _httpSender.setPolicy(policy);
+            }
+
+            void setRateLimiter(std::shared_ptr<RateLimiter> rateLimiter)
+            {
+                _httpSender.setRateLimiter(std::move(rateLimiter));
+            }
+
+            void setResultCache(std::shared_ptr<TranscriptionCache> cache)
+            {
+                _resultCache = std::move(cache);
+            }
+
+            void setDecodeProfile(DecodeProfile profile)
+            {
+                _decodeProfile = profile;
+            }
+
             PrerecordedTranscriptionResult transcribeUrl(const std::string &audioUrl,
                                                            const LiveTranscriptionOptions &options)
             {
@@ -41,20 +69,14 @@ namespace deepgram
                 request.headers["Authorization"] = "Token " + _apiKey;
                 request.content_type = "application/json";
                 request.body = nlohmann::json{{"url", audioUrl}}.dump();
-                return doSend(request);
+                return doSend(request, _decodeProfile);
             }
 
             PrerecordedTranscriptionResult transcribeBuffer(const std::vector<uint8_t> &audioData,
                                                               const std::string &contentType,
                                                               const LiveTranscriptionOptions &options)
             {
-                transport::HttpRequest request;
-                request.method = transport::HttpMethod::Post;
-                request.url = "https://" + _host + options.toQueryString();
-                request.headers["Authorization"] = "Token " + _apiKey;
-                request.content_type = contentType;
-                request.binary_body = audioData;
-                return doSend(request);
+                return transcribeBuffer(audioData, contentType, options, _decodeProfile);
             }
 
             PrerecordedTranscriptionResult transcribeFile(const std::string &filePath,
@@ -71,11 +93,25 @@ namespace deepgram
                     std::streamsize size = file.tellg();
                     file.seekg(0, std::ios::beg);
                     std::vector<uint8_t> buffer(size);
-                    if (size > 0 && !file.read(reinterpret_cast<char *>(buffer.data()), size))
+
+                    // Hash each chunk right after reading it, while it's still
+                    // in cache, instead of re-walking the whole file afterwards.
+                    constexpr std::streamsize chunkSize = 1 << 20;
+                    ContentHasher hasher;
+                    for (std::streamsize offset = 0; offset < size; offset += chunkSize)
                     {
-                        throw std::runtime_error("Failed to read audio file: " + filePath);
+                        const std::streamsize count = std::min(chunkSize, size - offset);
+                        if (!file.read(reinterpret_cast<char *>(buffer.data() + offset), count))
+                        {
+                            throw std::runtime_error("Failed to read audio file: " + filePath);
+                        }
+                        if (_resultCache)
+                        {
+                            hasher.update(buffer.data() + offset, static_cast<std::size_t>(count));
+                        }
                     }
-                    return transcribeBuffer(buffer, contentType, options);
+                    return _resultCache ? cachedOrSend(buffer, hasher, contentType, options, _decodeProfile)
+                                        : sendBuffer(buffer, contentType, options, _decodeProfile);
                 }
                 catch (const std::exception &e)
                 {
@@ -87,14 +123,190 @@ namespace deepgram
                 }
             }
 
+            PrerecordedTranscriptionResult transcribeSegmented(const std::vector<uint8_t> &audioData,
+                                                                 const LiveTranscriptionOptions &options,
+                                                                 const SegmentationOptions &segmentOptions)
+            {
+                if (options.encoding != encoding::LINEAR_16 || options.sampleRate <= 0 || options.channels <= 0)
+                {
+                    PrerecordedTranscriptionResult result;
+                    result.errorMessage = "transcribeSegmented requires LINEAR_16 audio with a known sample rate and channel count";
+                    spdlog::error("{}", result.errorMessage);
+                    return result;
+                }
+
+                const auto segments = segmentation::plan(audioData, options.sampleRate, options.channels, segmentOptions);
+                if (segments.size() <= 1)
+                {
+                    return transcribeBuffer(audioData, "audio/L16", options);
+                }
+
+                const std::size_t frameBytes = sizeof(int16_t) * static_cast<std::size_t>(options.channels);
+                std::vector<PrerecordedTranscriptionResult> results(segments.size());
+                std::atomic<std::size_t> nextIndex{0};
+                std::atomic<bool> failed{false};
+
+                auto worker = [&]()
+                {
+                    for (;;)
+                    {
+                        const std::size_t index = nextIndex.fetch_add(1);
+                        if (index >= segments.size() || failed.load())
+                        {
+                            return;
+                        }
+                        const auto &segment = segments[index];
+                        const std::vector<uint8_t> piece(audioData.begin() + segment.audioBegin * frameBytes,
+                                                         audioData.begin() + segment.audioEnd * frameBytes);
+                        // Stitching needs every segment's word timings.
+                        results[index] = transcribeBuffer(piece, "audio/L16", options, DecodeProfile::Full);
+                        if (!results[index].success)
+                        {
+                            failed.store(true);
+                        }
+                    }
+                };
+
+                const int workerCount = std::max(1, std::min<int>(segmentOptions.concurrency, static_cast<int>(segments.size())));
+                spdlog::debug("Transcribing {} segments with {} concurrent requests", segments.size(), workerCount);
+                std::vector<std::thread> workers;
+                workers.reserve(workerCount);
+                for (int i = 0; i < workerCount; ++i)
+                {
+                    workers.emplace_back(worker);
+                }
+                for (auto &thread : workers)
+                {
+                    thread.join();
+                }
+
+                if (failed.load())
+                {
+                    // Report the first segment that actually failed; segments
+                    // skipped after the failure were never sent.
+                    for (auto &segmentResult : results)
+                    {
+                        if (!segmentResult.success && (segmentResult.statusCode != 0 || !segmentResult.errorMessage.empty()))
+                        {
+                            return std::move(segmentResult);
+                        }
+                    }
+                    PrerecordedTranscriptionResult result;
+                    result.errorMessage = "Segment transcription failed";
+                    return result;
+                }
+
+                std::vector<PrerecordedTranscriptionResponse> responses;
+                responses.reserve(results.size());
+                for (auto &segmentResult : results)
+                {
+                    responses.push_back(std::move(segmentResult.response));
+                }
+
+                PrerecordedTranscriptionResult result;
+                result.success = true;
+                result.statusCode = results.front().statusCode;
+                result.response = segmentation::merge(segments, responses, options.sampleRate, audioData.size() / frameBytes);
+                applyDecodeProfile(result.response, _decodeProfile);
+                return result;
+            }
+
         private:
-            PrerecordedTranscriptionResult doSend(const transport::HttpRequest &request)
+            PrerecordedTranscriptionResult transcribeBuffer(const std::vector<uint8_t> &audioData,
+                                                              const std::string &contentType,
+                                                              const LiveTranscriptionOptions &options,
+                                                              DecodeProfile profile)
+            {
+                if (!_resultCache)
+                {
+                    return sendBuffer(audioData, contentType, options, profile);
+                }
+                ContentHasher hasher;
+                hasher.update(audioData.data(), audioData.size());
+                return cachedOrSend(audioData, hasher, contentType, options, profile);
+            }
+
+            PrerecordedTranscriptionResult sendBuffer(const std::vector<uint8_t> &audioData,
+                                                        const std::string &contentType,
+                                                        const LiveTranscriptionOptions &options,
+                                                        DecodeProfile profile)
+            {
+                transport::HttpRequest request;
+                request.method = transport::HttpMethod::Post;
+                request.url = "https://" + _host + options.toQueryString();
+                request.headers["Authorization"] = "Token " + _apiKey;
+                request.content_type = contentType;
+                request.binary_body = audioData;
+                return doSend(request, profile);
+            }
+
+            PrerecordedTranscriptionResult cachedOrSend(const std::vector<uint8_t> &audioData,
+                                                          const ContentHasher &hasher,
+                                                          const std::string &contentType,
+                                                          const LiveTranscriptionOptions &options,
+                                                          DecodeProfile profile)
+            {
+                const std::string key = cacheKey(hasher, contentType, options, profile);
+                if (auto cached = _resultCache->get(key))
+                {
+                    spdlog::debug("Transcription cache hit for {} bytes of {}", audioData.size(), contentType);
+                    PrerecordedTranscriptionResult result;
+                    result.success = true;
+                    result.statusCode = 200;
+                    result.fromCache = true;
+                    result.response = std::move(*cached);
+                    return result;
+                }
+                PrerecordedTranscriptionResult result = sendBuffer(audioData, contentType, options, profile);
+                if (result.success)
+                {
+                    _resultCache->put(key, result.response);
+                }
+                return result;
+            }
+
+            /**
+             * Audio hash and length, content type, decode profile and the query
+             * parameters in sorted order, so options that only differ in how
+             * they were serialized still share entries, while responses decoded
+             * with fewer fields never stand in for fuller ones.
+             */
+            static std::string cacheKey(const ContentHasher &hasher,
+                                        const std::string &contentType,
+                                        const LiveTranscriptionOptions &options,
+                                        DecodeProfile profile)
+            {
+                const std::string query = options.toQueryString();
+                std::vector<std::string> params;
+                std::size_t begin = query.find('?');
+                begin = begin == std::string::npos ? query.size() : begin + 1;
+                while (begin < query.size())
+                {
+                    std::size_t end = query.find('&', begin);
+                    end = end == std::string::npos ? query.size() : end;
+                    params.push_back(query.substr(begin, end - begin));
+                    begin = end + 1;
+                }
+                std::sort(params.begin(), params.end());
+
+                std::string key = ContentHasher::toHex(hasher.digest()) + ":" +
+                                  std::to_string(hasher.totalLength()) + ":" + contentType + ":" +
+                                  std::to_string(static_cast<int>(profile)) + ":";
+                for (const auto &param : params)
+                {
+                    key += param;
+                    key += '&';
+                }
+                return key;
+            }
+
+            PrerecordedTranscriptionResult doSend(const transport::HttpRequest &request, DecodeProfile profile)
             {
                 PrerecordedTranscriptionResult result;
                 transport::HttpResponse response;
                 try
                 {
-                    response = _httpTransport->send(request);
+                    response = _httpSender.send(request);
                 }
                 catch (const std::exception &e)
                 {
@@ -117,7 +329,7 @@ namespace deepgram
 
                 try
                 {
-                    nlohmann::json json = nlohmann::json::parse(bodyText);
+                    nlohmann::json json = parseWithProfile(bodyText, profile);
                     result.response = PrerecordedTranscriptionResponse::fromJson(json);
                     result.success = true;
                 }
@@ -132,7 +344,9 @@ namespace deepgram
 
             std::string _host;
             std::string _apiKey;
-            std::shared_ptr<transport::IHttpTransport> _httpTransport;
+            RetryingHttpSender _httpSender;
+            std::shared_ptr<TranscriptionCache> _resultCache;
+            DecodeProfile _decodeProfile = DecodeProfile::Full;
         };
     }
 }
@@ -0,0 +1,560 @@
+#pragma once
+
+#include "../../include/deepgrampp/listen.hpp"
+#include "../../include/deepgrampp/listen-pmr.hpp"
+
+#include <nlohmann/json.hpp>
+
+#include <cstdint>
+#include <memory_resource>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace deepgram
+{
+    namespace listen
+    {
+        /**
+         * Everything the listen message handlers need from one server message
+         * decoded by ListenMessageSax.
+         */
+        struct ListenMessage
+        {
+            TranscriptionResult result;           // `type` is always set
+            std::optional<double> lastWordEnd;    // UtteranceEnd
+            std::optional<double> timestamp;      // SpeechStarted
+        };
+
+        namespace pmr
+        {
+            /**
+             * ListenMessage whose result lives in a caller-supplied memory_resource.
+             */
+            struct ListenMessage
+            {
+                TranscriptionResult result;
+                std::optional<double> lastWordEnd;
+                std::optional<double> timestamp;
+
+                explicit ListenMessage(std::pmr::memory_resource *resource)
+                    : result(allocator_type(resource))
+                {
+                }
+            };
+        }
+
+        namespace detail
+        {
+            inline void assignText(std::string &target, std::string &value)
+            {
+                target = std::move(value);
+            }
+
+            inline void assignText(std::optional<std::string> &target, std::string &value)
+            {
+                target = std::move(value);
+            }
+
+            // Copies into the target's arena and leaves the parser's token
+            // buffer in place for the next value.
+            inline void assignText(std::pmr::string &target, std::string &value)
+            {
+                target.assign(value.data(), value.size());
+            }
+        }
+
+        /**
+         * nlohmann SAX handler that fills a ListenMessage (or pmr::ListenMessage)
+         * straight from the token stream: no intermediate DOM, and no allocations
+         * beyond the strings and vectors that end up in the result; its own
+         * scratch state comes from `scratch`. Keys it doesn't know, and those
+         * the DecodeProfile excludes, are skipped; values of unexpected types
+         * are ignored rather than thrown on (a numeric `speaker` is stored as
+         * its decimal text).
+         */
+        template <typename Message>
+        class BasicListenMessageSax
+        {
+        public:
+            using number_integer_t = nlohmann::json::number_integer_t;
+            using number_unsigned_t = nlohmann::json::number_unsigned_t;
+            using number_float_t = nlohmann::json::number_float_t;
+            using string_t = nlohmann::json::string_t;
+            using binary_t = nlohmann::json::binary_t;
+
+            explicit BasicListenMessageSax(Message &message, DecodeProfile profile = DecodeProfile::Full,
+                                           std::pmr::memory_resource *scratch = std::pmr::get_default_resource())
+                : _message(message), _profile(profile), _stack(scratch), _key(scratch)
+            {
+                _stack.reserve(8);
+            }
+
+            bool null()
+            {
+                return true;
+            }
+
+            bool boolean(bool value)
+            {
+                if (parent() == Node::Root)
+                {
+                    if (_key == "is_final")
+                    {
+                        _message.result.isFinal = value;
+                    }
+                    else if (_key == "speech_final")
+                    {
+                        _message.result.speech_final = value;
+                    }
+                    else if (_key == "from_finalize")
+                    {
+                        _message.result.isFromFinalize = value;
+                    }
+                }
+                return true;
+            }
+
+            bool number_integer(number_integer_t value)
+            {
+                return number(static_cast<double>(value), nullptr, value);
+            }
+
+            bool number_unsigned(number_unsigned_t value)
+            {
+                return number(static_cast<double>(value), nullptr, static_cast<number_integer_t>(value));
+            }
+
+            bool number_float(number_float_t value, const string_t &text)
+            {
+                return number(value, &text, 0);
+            }
+
+            bool string(string_t &value)
+            {
+                switch (parent())
+                {
+                case Node::Root:
+                    if (_key == "type")
+                    {
+                        detail::assignText(_message.result.type, value);
+                    }
+                    break;
+                case Node::Alternative:
+                {
+                    auto &alt = _message.result.channel.alternatives.back();
+                    if (_key == "transcript")
+                    {
+                        detail::assignText(alt.transcript, value);
+                    }
+                    else if (_key == "language")
+                    {
+                        detail::assignText(alt.language, value);
+                    }
+                    break;
+                }
+                case Node::Word:
+                {
+                    auto &word = currentWord();
+                    if (_key == "word")
+                    {
+                        detail::assignText(word.word, value);
+                    }
+                    else if (_profile != DecodeProfile::Full)
+                    {
+                        break;
+                    }
+                    else if (_key == "punctuated_word")
+                    {
+                        detail::assignText(word.punctuated_word, value);
+                    }
+                    else if (_key == "speaker")
+                    {
+                        detail::assignText(word.speaker, value);
+                    }
+                    else if (_key == "speaker_confidence")
+                    {
+                        detail::assignText(word.speakerConfidence, value);
+                    }
+                    break;
+                }
+                default:
+                    break;
+                }
+                return true;
+            }
+
+            bool binary(binary_t &)
+            {
+                return true;
+            }
+
+            bool start_object(std::size_t)
+            {
+                Node node = Node::Other;
+                const Node outer = parent();
+                if (_stack.empty())
+                {
+                    node = Node::Root;
+                }
+                else if (outer == Node::Root && _key == "channel")
+                {
+                    node = Node::Channel;
+                }
+                else if (outer == Node::Alternatives)
+                {
+                    node = Node::Alternative;
+                    _message.result.channel.alternatives.emplace_back().confidence = 0.0;
+                }
+                else if (outer == Node::Words)
+                {
+                    node = Node::Word;
+                    auto &word = _message.result.channel.alternatives.back().words.emplace_back();
+                    word.start = word.end = word.confidence = 0.0;
+                }
+                _stack.push_back(node);
+                return true;
+            }
+
+            bool key(string_t &value)
+            {
+                _key.assign(value);
+                return true;
+            }
+
+            bool end_object()
+            {
+                _stack.pop_back();
+                return true;
+            }
+
+            bool start_array(std::size_t)
+            {
+                Node node = Node::Other;
+                const Node outer = parent();
+                if (outer == Node::Channel && _key == "alternatives")
+                {
+                    node = Node::Alternatives;
+                }
+                else if (outer == Node::Alternative && _key == "words" && _profile != DecodeProfile::TranscriptOnly)
+                {
+                    node = Node::Words;
+                }
+                _stack.push_back(node);
+                return true;
+            }
+
+            bool end_array()
+            {
+                _stack.pop_back();
+                return true;
+            }
+
+            bool parse_error(std::size_t position, const std::string &, const nlohmann::detail::exception &e)
+            {
+                throw std::runtime_error("invalid JSON at byte " + std::to_string(position) + ": " + e.what());
+            }
+
+        private:
+            enum class Node : std::uint8_t
+            {
+                None,
+                Root,
+                Channel,
+                Alternatives,
+                Alternative,
+                Words,
+                Word,
+                Other
+            };
+
+            Node parent() const
+            {
+                return _stack.empty() ? Node::None : _stack.back();
+            }
+
+            auto &currentWord()
+            {
+                return _message.result.channel.alternatives.back().words.back();
+            }
+
+            bool number(double value, const string_t *text, number_integer_t integer)
+            {
+                switch (parent())
+                {
+                case Node::Root:
+                    if (_key == "duration")
+                    {
+                        _message.result.duration = value;
+                    }
+                    else if (_key == "start")
+                    {
+                        _message.result.start = value;
+                    }
+                    else if (_key == "last_word_end")
+                    {
+                        _message.lastWordEnd = value;
+                    }
+                    else if (_key == "timestamp")
+                    {
+                        _message.timestamp = value;
+                    }
+                    break;
+                case Node::Alternative:
+                    if (_key == "confidence")
+                    {
+                        _message.result.channel.alternatives.back().confidence = value;
+                    }
+                    break;
+                case Node::Word:
+                {
+                    auto &word = currentWord();
+                    if (_key == "start")
+                    {
+                        word.start = value;
+                    }
+                    else if (_key == "end")
+                    {
+                        word.end = value;
+                    }
+                    else if (_key == "confidence")
+                    {
+                        word.confidence = value;
+                    }
+                    else if (_profile != DecodeProfile::Full)
+                    {
+                        break;
+                    }
+                    else if (_key == "speaker")
+                    {
+                        std::string digits = text ? *text : std::to_string(integer);
+                        detail::assignText(word.speaker, digits);
+                    }
+                    else if (_key == "speaker_confidence")
+                    {
+                        std::string digits = text ? *text : std::to_string(integer);
+                        detail::assignText(word.speakerConfidence, digits);
+                    }
+                    break;
+                }
+                default:
+                    break;
+                }
+                return true;
+            }
+
+            Message &_message;
+            DecodeProfile _profile;
+            std::pmr::vector<Node> _stack;
+            std::pmr::string _key;
+        };
+
+        using ListenMessageSax = BasicListenMessageSax<ListenMessage>;
+
+        /**
+         * Decodes one server message with ListenMessageSax. Throws
+         * std::runtime_error on malformed JSON, like the DOM path does.
+         */
+        inline ListenMessage decodeListenMessageSax(const std::string &text, DecodeProfile profile = DecodeProfile::Full)
+        {
+            ListenMessage message;
+            message.result.speech_final = false;
+            ListenMessageSax handler(message, profile);
+            nlohmann::json::sax_parse(text, &handler);
+            return message;
+        }
+
+        /**
+         * Decodes one server message into `message`, taking the result and the
+         * parser's scratch state from the message's memory_resource.
+         */
+        inline void decodeListenMessageSax(const std::string &text, pmr::ListenMessage &message,
+                                           DecodeProfile profile = DecodeProfile::Full)
+        {
+            std::pmr::memory_resource *resource = message.result.type.get_allocator().resource();
+            BasicListenMessageSax<pmr::ListenMessage> handler(message, profile, resource);
+            nlohmann::json::sax_parse(text, &handler);
+        }
+
+        /**
+         * SAX handler for live Metadata messages, filling Metadata (model info
+         * included) without a DOM.
+         */
+        class MetadataSax
+        {
+        public:
+            using number_integer_t = nlohmann::json::number_integer_t;
+            using number_unsigned_t = nlohmann::json::number_unsigned_t;
+            using number_float_t = nlohmann::json::number_float_t;
+            using string_t = nlohmann::json::string_t;
+            using binary_t = nlohmann::json::binary_t;
+
+            explicit MetadataSax(Metadata &metadata)
+                : _metadata(metadata)
+            {
+            }
+
+            bool null() { return true; }
+            bool boolean(bool) { return true; }
+            bool binary(binary_t &) { return true; }
+
+            bool number_integer(number_integer_t value)
+            {
+                return number(static_cast<double>(value));
+            }
+
+            bool number_unsigned(number_unsigned_t value)
+            {
+                return number(static_cast<double>(value));
+            }
+
+            bool number_float(number_float_t value, const string_t &)
+            {
+                return number(value);
+            }
+
+            bool string(string_t &value)
+            {
+                switch (parent())
+                {
+                case Node::Root:
+                    if (_key == "transaction_key")
+                    {
+                        _metadata.transaction_key = std::move(value);
+                    }
+                    else if (_key == "request_id")
+                    {
+                        _metadata.request_id = std::move(value);
+                    }
+                    else if (_key == "sha256")
+                    {
+                        _metadata.sha256 = std::move(value);
+                    }
+                    else if (_key == "created")
+                    {
+                        _metadata.created = std::move(value);
+                    }
+                    break;
+                case Node::Models:
+                    _metadata.models.push_back(std::move(value));
+                    break;
+                case Node::Model:
+                {
+                    ModelInfo &info = _metadata.model_info.back();
+                    if (_key == "name")
+                    {
+                        info.name = std::move(value);
+                    }
+                    else if (_key == "version")
+                    {
+                        info.version = std::move(value);
+                    }
+                    else if (_key == "arch")
+                    {
+                        info.arch = std::move(value);
+                    }
+                    break;
+                }
+                default:
+                    break;
+                }
+                return true;
+            }
+
+            bool start_object(std::size_t)
+            {
+                Node node = Node::Other;
+                const Node outer = parent();
+                if (_stack.empty())
+                {
+                    node = Node::Root;
+                }
+                else if (outer == Node::Root && _key == "model_info")
+                {
+                    node = Node::ModelInfo;
+                }
+                else if (outer == Node::ModelInfo)
+                {
+                    node = Node::Model;
+                    _metadata.model_info.emplace_back().uuid = _key;
+                }
+                _stack.push_back(node);
+                return true;
+            }
+
+            bool end_object()
+            {
+                _stack.pop_back();
+                return true;
+            }
+
+            bool start_array(std::size_t)
+            {
+                _stack.push_back(parent() == Node::Root && _key == "models" ? Node::Models : Node::Other);
+                return true;
+            }
+
+            bool end_array()
+            {
+                _stack.pop_back();
+                return true;
+            }
+
+            bool key(string_t &value)
+            {
+                _key.assign(value);
+                return true;
+            }
+
+            bool parse_error(std::size_t position, const std::string &, const nlohmann::detail::exception &e)
+            {
+                throw std::runtime_error("invalid JSON at byte " + std::to_string(position) + ": " + e.what());
+            }
+
+        private:
+            enum class Node : std::uint8_t
+            {
+                None,
+                Root,
+                Models,
+                ModelInfo,
+                Model,
+                Other
+            };
+
+            Node parent() const
+            {
+                return _stack.empty() ? Node::None : _stack.back();
+            }
+
+            bool number(double value)
+            {
+                if (parent() == Node::Root)
+                {
+                    if (_key == "duration")
+                    {
+                        _metadata.duration = value;
+                    }
+                    else if (_key == "channels")
+                    {
+                        _metadata.channels = static_cast<int>(value);
+                    }
+                }
+                return true;
+            }
+
+            Metadata &_metadata;
+            std::vector<Node> _stack;
+            std::string _key;
+        };
+
+        inline Metadata decodeMetadataSax(const std::string &text)
+        {
+            Metadata metadata;
+            MetadataSax handler(metadata);
+            nlohmann::json::sax_parse(text, &handler);
+            return metadata;
+        }
+    }
+}
@@ -0,0 +1,200 @@
+#pragma once
+
+#include "../../include/deepgrampp/listen-rest.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <vector>
+
+namespace deepgram
+{
+    namespace listen
+    {
+        namespace segmentation
+        {
+            /**
+             * One piece of a long LINEAR_16 recording, in sample frames (one frame
+             * = one sample for every channel). [cutBegin, cutEnd) is the part this
+             * segment is authoritative for; [audioBegin, audioEnd) additionally
+             * includes the overlap shared with its neighbours.
+             */
+            struct Segment
+            {
+                std::size_t audioBegin = 0;
+                std::size_t audioEnd = 0;
+                std::size_t cutBegin = 0;
+                std::size_t cutEnd = 0;
+            };
+
+            /**
+             * Mean absolute amplitude of `frames` frames starting at `begin`, over
+             * every channel. Cheap stand-in for loudness when looking for a pause.
+             */
+            inline double meanAbsAmplitude(const std::vector<uint8_t> &pcm, int channels,
+                                           std::size_t begin, std::size_t frames)
+            {
+                const std::size_t samples = frames * static_cast<std::size_t>(channels);
+                const std::size_t offset = begin * static_cast<std::size_t>(channels) * sizeof(int16_t);
+                double sum = 0.0;
+                for (std::size_t i = 0; i < samples; ++i)
+                {
+                    int16_t sample;
+                    std::memcpy(&sample, pcm.data() + offset + i * sizeof(int16_t), sizeof(sample));
+                    sum += std::abs(static_cast<int>(sample));
+                }
+                return samples > 0 ? sum / static_cast<double>(samples) : 0.0;
+            }
+
+            /**
+             * Splits `totalFrames` frames into segments of roughly
+             * `options.segmentSeconds`. With `splitOnSilence`, each cut is moved to
+             * the quietest 20 ms window within `silenceSearchSeconds` before the
+             * nominal boundary so that cuts rarely land inside a word.
+             */
+            inline std::vector<Segment> plan(const std::vector<uint8_t> &pcm, int sampleRate, int channels,
+                                             const SegmentationOptions &options)
+            {
+                const std::size_t frameBytes = sizeof(int16_t) * static_cast<std::size_t>(channels);
+                const std::size_t totalFrames = pcm.size() / frameBytes;
+                const auto toFrames = [sampleRate](double seconds)
+                { return static_cast<std::size_t>(std::max(0.0, seconds) * sampleRate); };
+
+                const std::size_t segmentFrames = std::max<std::size_t>(toFrames(options.segmentSeconds), 1);
+                const std::size_t halfOverlap = toFrames(options.overlapSeconds) / 2;
+                const std::size_t searchFrames = std::min(toFrames(options.silenceSearchSeconds), segmentFrames / 2);
+                const std::size_t windowFrames = std::max<std::size_t>(toFrames(0.02), 1);
+
+                std::vector<std::size_t> cuts{0};
+                while (totalFrames - cuts.back() > segmentFrames)
+                {
+                    std::size_t cut = cuts.back() + segmentFrames;
+                    if (options.splitOnSilence && searchFrames >= windowFrames)
+                    {
+                        double quietest = std::numeric_limits<double>::max();
+                        for (std::size_t start = cut - searchFrames; start + windowFrames <= cut; start += windowFrames)
+                        {
+                            const double level = meanAbsAmplitude(pcm, channels, start, windowFrames);
+                            if (level < quietest)
+                            {
+                                quietest = level;
+                                cut = start + windowFrames / 2;
+                            }
+                        }
+                    }
+                    cuts.push_back(cut);
+                }
+                cuts.push_back(totalFrames);
+
+                std::vector<Segment> segments;
+                for (std::size_t i = 0; i + 1 < cuts.size(); ++i)
+                {
+                    Segment segment;
+                    segment.cutBegin = cuts[i];
+                    segment.cutEnd = cuts[i + 1];
+                    segment.audioBegin = segment.cutBegin > halfOverlap ? segment.cutBegin - halfOverlap : 0;
+                    segment.audioEnd = std::min(totalFrames, segment.cutEnd + halfOverlap);
+                    segments.push_back(segment);
+                }
+                return segments;
+            }
+
+            /**
+             * Stitches per-segment responses (same order as `segments`) back into
+             * one response on the original timeline: word timestamps are shifted
+             * by their segment's offset, and a word is kept only by the segment
+             * whose cut range contains its midpoint, which removes the duplicates
+             * transcribed twice in an overlap. Only the best alternative of each
+             * channel survives; its transcript is rebuilt from the kept words.
+             */
+            inline PrerecordedTranscriptionResponse merge(const std::vector<Segment> &segments,
+                                                           const std::vector<PrerecordedTranscriptionResponse> &responses,
+                                                           int sampleRate, std::size_t totalFrames)
+            {
+                PrerecordedTranscriptionResponse merged;
+                if (responses.empty())
+                {
+                    return merged;
+                }
+                merged.metadata = responses.front().metadata;
+                merged.metadata.duration = static_cast<double>(totalFrames) / sampleRate;
+
+                std::size_t channelCount = 0;
+                for (const auto &response : responses)
+                {
+                    channelCount = std::max(channelCount, response.channels.size());
+                }
+                merged.channels.resize(channelCount);
+
+                for (std::size_t c = 0; c < channelCount; ++c)
+                {
+                    Alternative best;
+                    best.confidence = 0.0;
+                    std::vector<std::string> transcriptsWithoutWords;
+
+                    for (std::size_t s = 0; s < segments.size() && s < responses.size(); ++s)
+                    {
+                        if (c >= responses[s].channels.size() || responses[s].channels[c].alternatives.empty())
+                        {
+                            continue;
+                        }
+                        const Alternative &alt = responses[s].channels[c].alternatives.front();
+                        if (!best.language && alt.language)
+                        {
+                            best.language = alt.language;
+                        }
+                        if (alt.words.empty())
+                        {
+                            if (!alt.transcript.empty())
+                            {
+                                transcriptsWithoutWords.push_back(alt.transcript);
+                            }
+                            continue;
+                        }
+
+                        const double offset = static_cast<double>(segments[s].audioBegin) / sampleRate;
+                        const double keepFrom = static_cast<double>(segments[s].cutBegin) / sampleRate;
+                        const double keepUntil = static_cast<double>(segments[s].cutEnd) / sampleRate;
+                        for (const Word &word : alt.words)
+                        {
+                            const double midpoint = offset + (word.start + word.end) / 2.0;
+                            if (midpoint < keepFrom || midpoint >= keepUntil)
+                            {
+                                continue;
+                            }
+                            Word shifted = word;
+                            shifted.start += offset;
+                            shifted.end += offset;
+                            best.words.push_back(std::move(shifted));
+                        }
+                    }
+
+                    for (const Word &word : best.words)
+                    {
+                        if (!best.transcript.empty())
+                        {
+                            best.transcript += ' ';
+                        }
+                        best.transcript += word.punctuated_word.value_or(word.word);
+                        best.confidence += word.confidence;
+                    }
+                    if (!best.words.empty())
+                    {
+                        best.confidence /= static_cast<double>(best.words.size());
+                    }
+                    // Segments that came back without word timings can't be
+                    // de-duplicated; their transcripts are appended as-is.
+                    for (const auto &transcript : transcriptsWithoutWords)
+                    {
+                        best.transcript += (best.transcript.empty() ? "" : " ") + transcript;
+                    }
+                    merged.channels[c].alternatives.push_back(std::move(best));
+                }
+                return merged;
+            }
+        }
+    }
+}
@@ -1,14 +1,24 @@
 #pragma once
 
 #include "../../include/deepgrampp/listen-ws.hpp"
+#include "../../include/deepgrampp/audio/pacing.hpp"
 #include "../../include/deepgrampp/transport/lws_websocket_transport.hpp"
+#include "audio-pipeline.hpp"
+#include "audio-pump.hpp"
+#include "close-latch.hpp"
+#include "message-router.hpp"
+#include "result-arena.hpp"
+#include "stream-slot.hpp"
+#include "timer-wheel.hpp"
 
 #include <spdlog/spdlog.h>
 
 #include <algorithm>
+#include <atomic>
 #include <chrono>
 #include <functional>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <thread>
 
@@ -43,8 +53,75 @@ namespace deepgram
             void setHandlers(std::function<void(const std::string &)> onMessage,
                               std::function<void(const std::string &)> onError)
             {
-                _wsTransport->setOnTextMessage(std::move(onMessage));
+                // Metadata is the server's last message of a session; close()
+                // waits for it once delivered, or for the close frame.
+                _wsTransport->setOnTextMessage([this, onMessage = std::move(onMessage)](const std::string &message)
+                                               {
+                    onMessage(message);
+                    if (peekMessageType(message) == std::string_view(result::METADATA))
+                    {
+                        _closeLatch.signal();
+                    } });
                 _wsTransport->setOnError(std::move(onError));
+                _wsTransport->setOnClose([this]()
+                                         {
+                    _streamSlot.release();
+                    _closeLatch.signal(); });
+            }
+
+            void setCloseTimeout(std::chrono::milliseconds timeout)
+            {
+                _closeTimeout = timeout;
+            }
+
+            void setRateLimiter(std::shared_ptr<RateLimiter> rateLimiter)
+            {
+                _streamSlot.setRateLimiter(std::move(rateLimiter));
+            }
+
+            MessageRouter &router()
+            {
+                return _router;
+            }
+
+            ResultArena &resultArena()
+            {
+                return _resultArena;
+            }
+
+            void setPushOptions(const audio::PushOptions &options)
+            {
+                _pushOptions = options;
+            }
+
+            void setAudioInputFormat(const audio::AudioFormat &format)
+            {
+                _pipeline.setInputFormat(format);
+            }
+
+            void addAudioStage(std::shared_ptr<audio::IAudioStage> stage)
+            {
+                _pipeline.add(std::move(stage));
+            }
+
+            void setVoiceActivityGate(std::shared_ptr<audio::VoiceActivityGate> gate)
+            {
+                _voiceGate = gate;
+                _pipeline.setGate(std::move(gate));
+            }
+
+#if defined(DEEPGRAMPP_WITH_OPUS)
+            void setOpusEncoder(std::shared_ptr<audio::OpusEncoderStage> encoder)
+            {
+                _opusEncoder = encoder;
+                _pipeline.setEncoder(std::move(encoder));
+            }
+#endif
+
+            // Set before connect(), so the receiving thread only ever reads it.
+            const audio::VoiceActivityGate *voiceGate() const
+            {
+                return _voiceGate.get();
             }
 
             bool connect(const LiveTranscriptionOptions &options)
@@ -54,15 +131,64 @@ namespace deepgram
                     spdlog::warn("Already connected to Deepgram.");
                     return true;
                 }
+                RateLimiter::Permit permit = _streamSlot.acquire();
                 try
                 {
+                    // The options describe the PCM handed to the stages; an
+                    // encoder replaces it on the wire.
+                    const audio::AudioFormat described = audio::wireFormat(options.encoding, options.sampleRate, options.channels);
+                    audio::AudioFormat pcm = described;
+                    LiveTranscriptionOptions wireOptions = options;
+#if defined(DEEPGRAMPP_WITH_OPUS)
+                    if (_opusEncoder)
+                    {
+                        if (!pcm.linear())
+                        {
+                            pcm = audio::wireFormat("linear16", options.sampleRate, options.channels);
+                        }
+                        if (!audio::OpusEncoderStage::supportsRate(pcm.sampleRate))
+                        {
+                            spdlog::warn("Opus can't encode at {} Hz, resampling to 48000 Hz", pcm.sampleRate);
+                            pcm.sampleRate = 48000;
+                        }
+                        if (pcm.channels > 2)
+                        {
+                            spdlog::warn("Opus encodes at most 2 channels, mixing {} down to 2", pcm.channels);
+                            pcm.channels = 2;
+                        }
+                        wireOptions.encoding = _opusEncoder->encoding();
+                        wireOptions.sampleRate = pcm.sampleRate;
+                        wireOptions.channels = pcm.channels;
+                    }
+                    _rawPackets = _opusEncoder && _opusEncoder->options().container == audio::OpusContainer::Raw;
+#endif
+
                     transport::WebSocketConnectOptions wsOptions;
-                    wsOptions.url = "wss://" + _host + options.toQueryString();
+                    wsOptions.url = "wss://" + _host + wireOptions.toQueryString();
                     wsOptions.headers["Authorization"] = "Token " + _apiKey;
                     wsOptions.headers["User-Agent"] = "DeepgramCppClient/1.0";
 
                     spdlog::debug("Connecting to {} ...", wsOptions.url);
+                    _closeLatch.arm();
                     _wsTransport->connect(wsOptions);
+                    _streamSlot.hold(std::move(permit));
+                    _encoding = wireOptions.encoding;
+                    _sampleRate = wireOptions.sampleRate;
+                    _channels = wireOptions.channels;
+                    {
+                        std::lock_guard<std::mutex> lk(_pipelineMutex);
+                        _inputFormat = _pipeline.configure(pcm, &described);
+                    }
+                    const std::size_t frameBytes = audio::bytesPerSampleFrame(_encoding, _channels);
+                    _audioPump.start(_wsTransport, _pushOptions, frameBytes * static_cast<std::size_t>(std::max(_sampleRate, 0)), frameBytes);
+                    _lastAudioSent.store(std::chrono::steady_clock::now().time_since_epoch().count(), std::memory_order_relaxed);
+                    if (_voiceGate)
+                    {
+                        // While the gate holds silence back the server hears
+                        // nothing; the keepalive timer fills in, off the
+                        // sending thread.
+                        startKeepalive();
+                    }
                     spdlog::debug("WebSocket connected successfully!");
                     return true;
                 }
@@ -73,27 +199,21 @@ namespace deepgram
                 }
             }
 
+            /**
+             * Keepalives run on the process-wide TimerWheel rather than a thread
+             * per session, and are only sent when no audio went out for a whole
+             * interval -- audio keeps the connection alive by itself.
+             */
             void startKeepalive()
             {
-                _keepaliveThread = std::thread([this]()
-                                               {
-                spdlog::debug("Starting keepalive thread...");
-                while (_wsTransport->isOpen())
+                if (_keepaliveTimer != 0)
                 {
-                    std::this_thread::sleep_for(std::chrono::seconds(5));
-                    if (!_wsTransport->isOpen()) break;
-                    try
-                    {
-                        _wsTransport->sendText(std::string(control::KEEPALIVE_MESSAGE));
-                        spdlog::debug("Sent keepalive message");
-                    }
-                    catch (const std::exception &e)
-                    {
-                        spdlog::error("Keepalive error: {}", e.what());
-                        break;
-                    }
+                    // Retires itself once the socket closes, e.g. before a reconnect.
+                    TimerWheel::shared().cancel(_keepaliveTimer);
                 }
-                spdlog::debug("Keepalive thread ended."); });
+                spdlog::debug("Starting keepalive...");
+                _keepaliveTimer = TimerWheel::shared().schedule(kKeepaliveInterval, [this]()
+                                                                { return keepalive(); });
             }
 
             bool streamAudio(const std::vector<uint8_t> &audioData, size_t chunkSize = 4096)
@@ -117,33 +237,92 @@ namespace deepgram
                 return true;
             }
 
-            bool sendFinalizeMessage()
+            bool streamAudioPaced(const std::vector<uint8_t> &audioData, const audio::PacingOptions &pacing)
             {
-                return sendText(control::FINALIZE_MESSAGE);
+                if (!_wsTransport->isOpen())
+                {
+                    spdlog::error("Not connected to Deepgram.");
+                    return false;
+                }
+                // Paced at the rate of the audio as handed in, before any stage.
+                std::size_t frameBytes = _inputFormat.bytesPerFrame();
+                std::size_t bytesPerSecond = _inputFormat.bytesPerSecond();
+                if (frameBytes == 0)
+                {
+                    frameBytes = audio::bytesPerSampleFrame(_encoding, _channels);
+                    bytesPerSecond = frameBytes * static_cast<std::size_t>(std::max(_sampleRate, 0));
+                }
+                if (bytesPerSecond == 0)
+                {
+                    spdlog::error("can't pace {} audio: its byte rate can't be derived from the connection options", _encoding);
+                    return false;
+                }
+                return audio::streamPaced(audioData.data(), audioData.size(), bytesPerSecond,
+                                          frameBytes, pacing, [this](const uint8_t *data, std::size_t size)
+                                          { return sendAudioChunk(data, size); });
             }
 
-            bool sendAudioChunk(const uint8_t *data, size_t size)
+            bool pushAudio(const uint8_t *data, size_t size)
             {
-                if (!_wsTransport->isOpen())
+                if (_pipeline.empty())
                 {
-                    spdlog::error("can't send audio chunk, websocket not open");
+                    return _audioPump.push(data, size);
+                }
+                if (_rawPackets)
+                {
+                    spdlog::error("can't push raw Opus packets, the pump doesn't keep message boundaries; use the Ogg container");
                     return false;
                 }
-                try
+                // Stages run here, on the producer's thread, so the sender only
+                // ever moves wire-format bytes. Finalize and close drain them on
+                // the application's thread; rather than wait for that, the
+                // chunk is dropped like one that doesn't fit the ring.
+                std::unique_lock<std::mutex> lk(_pipelineMutex, std::try_to_lock);
+                if (!lk.owns_lock())
+                {
+                    _audioPump.drop(size);
+                    return false;
+                }
+                const AudioPipeline::Output out = _pipeline.process(data, size);
+                if (out.size == 0)
                 {
-                    _wsTransport->sendBinary(std::vector<uint8_t>(data, data + size));
                     return true;
                 }
-                catch (const std::exception &e)
+                return _audioPump.push(out.data, out.size);
+            }
+
+            std::size_t droppedAudioBytes() const
+            {
+                return _audioPump.droppedBytes();
+            }
+
+            bool sendFinalizeMessage()
+            {
+                _audioPump.flush();
+                drainPipeline();
+                return sendText(control::FINALIZE_MESSAGE);
+            }
+
+            bool sendAudioChunk(const uint8_t *data, size_t size)
+            {
+                if (_pipeline.empty())
                 {
-                    spdlog::error("Send chunk error: {}", e.what());
-                    return false;
+                    return sendWire(data, size);
+                }
+                std::lock_guard<std::mutex> lk(_pipelineMutex);
+                const AudioPipeline::Output out = _pipeline.process(data, size);
+                if (out.size == 0)
+                {
+                    return true;
                 }
+                return sendStaged(out.data, out.size);
             }
 
-            void sendCloseStream()
+            bool sendCloseStream()
             {
-                sendText(control::CLOSE_MESSAGE);
+                _audioPump.flush();
+                drainPipeline();
+                return sendText(control::CLOSE_MESSAGE);
             }
 
             void stopReceiving()
@@ -154,30 +333,109 @@ namespace deepgram
 
             void close()
             {
+                if (_keepaliveTimer != 0)
+                {
+                    TimerWheel::shared().cancel(_keepaliveTimer);
+                    _keepaliveTimer = 0;
+                }
+                _audioPump.stop();
                 if (_wsTransport->isOpen())
                 {
                     spdlog::debug("Closing connection...");
 
-                    sendCloseStream();
-                    // Wait a moment for final messages
-                    std::this_thread::sleep_for(std::chrono::milliseconds(500));
+                    // Returns as soon as the final results and Metadata are in.
+                    if (sendCloseStream() && !_closeLatch.wait(_closeTimeout))
+                    {
+                        spdlog::warn("no final Metadata within {} ms of CloseStream, closing anyway", _closeTimeout.count());
+                    }
 
                     _wsTransport->close();
                 }
+                _streamSlot.release();
+                spdlog::debug("Connection closed.");
+            }
+
+        private:
+            static constexpr std::chrono::milliseconds kKeepaliveInterval{5000};
 
-                // The keepalive thread's own loop exits once isOpen() goes false
-                // (whether that happened here or the socket was already closed,
-                // e.g. by the server), so it must always be joined here --
-                // otherwise a joinable std::thread left in the destructor calls
-                // std::terminate().
-                if (_keepaliveThread.joinable())
+            // Sends audio already in the wire format.
+            bool sendWire(const uint8_t *data, size_t size)
+            {
+                if (!_wsTransport->isOpen())
                 {
-                    _keepaliveThread.join();
+                    spdlog::error("can't send audio chunk, websocket not open");
+                    return false;
+                }
+                try
+                {
+                    _wsTransport->sendBinary(data, size);
+                    _lastAudioSent.store(std::chrono::steady_clock::now().time_since_epoch().count(), std::memory_order_relaxed);
+                    return true;
+                }
+                catch (const std::exception &e)
+                {
+                    spdlog::error("Send chunk error: {}", e.what());
+                    return false;
                 }
-                spdlog::debug("Connection closed.");
             }
 
-        private:
+            // Sends pipeline output. Raw Opus packets come length-prefixed
+            // and go out one per message.
+            bool sendStaged(const uint8_t *data, size_t size)
+            {
+                if (!_rawPackets)
+                {
+                    return sendWire(data, size);
+                }
+                while (size >= 2)
+                {
+                    const size_t packet = static_cast<size_t>(data[0]) | static_cast<size_t>(data[1]) << 8;
+                    if (packet > size - 2 || !sendWire(data + 2, packet))
+                    {
+                        return false;
+                    }
+                    data += 2 + packet;
+                    size -= 2 + packet;
+                }
+                return true;
+            }
+
+            // Sends what the stages held back; the pump must be flushed first.
+            void drainPipeline()
+            {
+                if (!_pipeline.empty())
+                {
+                    std::lock_guard<std::mutex> lk(_pipelineMutex);
+                    const AudioPipeline::Output tail = _pipeline.flush();
+                    if (tail.size > 0)
+                    {
+                        sendStaged(tail.data, tail.size);
+                    }
+                }
+            }
+
+            // Runs on the TimerWheel thread; returns when to check again.
+            std::chrono::milliseconds keepalive()
+            {
+                if (!_wsTransport->isOpen())
+                {
+                    spdlog::debug("Keepalive ended.");
+                    return std::chrono::milliseconds(0);
+                }
+                const std::chrono::steady_clock::time_point lastAudio{std::chrono::steady_clock::duration(
+                    std::max(_lastAudioSent.load(std::memory_order_relaxed), _audioPump.lastSendTime()))};
+                const auto idle = std::chrono::steady_clock::now() - lastAudio;
+                if (idle < kKeepaliveInterval)
+                {
+                    return std::chrono::ceil<std::chrono::milliseconds>(kKeepaliveInterval - idle);
+                }
+                if (sendText(control::KEEPALIVE_MESSAGE))
+                {
+                    spdlog::debug("Sent keepalive message");
+                }
+                return kKeepaliveInterval;
+            }
+
             bool sendText(const std::string &message)
             {
                 if (!_wsTransport->isOpen())
@@ -200,7 +458,26 @@ namespace deepgram
             std::string _host;
             std::string _apiKey;
             std::shared_ptr<transport::IWebSocketTransport> _wsTransport;
-            std::thread _keepaliveThread;
+            TimerWheel::TimerId _keepaliveTimer = 0;
+            std::atomic<std::chrono::steady_clock::rep> _lastAudioSent{0};
+            StreamSlot _streamSlot;
+            MessageRouter _router;
+            ResultArena _resultArena;
+            std::string _encoding;
+            int _sampleRate = 0;
+            int _channels = 0;
+            AudioPipeline _pipeline;
+            std::mutex _pipelineMutex; // serializes the sending thread with Finalize/close
+            std::shared_ptr<audio::VoiceActivityGate> _voiceGate;
+#if defined(DEEPGRAMPP_WITH_OPUS)
+            std::shared_ptr<audio::OpusEncoderStage> _opusEncoder;
+#endif
+            bool _rawPackets = false;
+            audio::AudioFormat _inputFormat;
+            audio::PushOptions _pushOptions;
+            AudioPump _audioPump;
+            CloseLatch _closeLatch;
+            std::chrono::milliseconds _closeTimeout{CloseLatch::kDefaultTimeout};
         };
     }
 }
@@ -0,0 +1,118 @@
+#pragma once
+
+#include <cstddef>
+#include <list>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+namespace deepgram
+{
+    /**
+     * String-keyed LRU map bounded by a total cost: every entry declares its
+     * cost on insert (1 for a plain entry count, its size in bytes for a byte
+     * budget) and the least recently used entries are evicted until the total
+     * fits `capacity` again. Not synchronized; owners lock around it.
+     */
+    template <typename Value>
+    class LruCache
+    {
+    public:
+        explicit LruCache(std::size_t capacity = 0)
+            : _capacity(capacity)
+        {
+        }
+
+        void setCapacity(std::size_t capacity)
+        {
+            _capacity = capacity;
+            evict();
+        }
+
+        /**
+         * Returns a pointer to the cached value (valid until the next mutation)
+         * and marks it most recently used, or null on a miss.
+         */
+        const Value *find(const std::string &key)
+        {
+            const auto it = _index.find(key);
+            if (it == _index.end())
+            {
+                return nullptr;
+            }
+            _entries.splice(_entries.begin(), _entries, it->second);
+            return &it->second->value;
+        }
+
+        /**
+         * Inserts or replaces `key`. A single value costlier than the whole
+         * capacity isn't kept at all.
+         */
+        void put(const std::string &key, Value value, std::size_t cost = 1)
+        {
+            erase(key);
+            if (cost > _capacity)
+            {
+                return;
+            }
+            _entries.push_front(Entry{key, std::move(value), cost});
+            _index.emplace(key, _entries.begin());
+            _totalCost += cost;
+            evict();
+        }
+
+        void erase(const std::string &key)
+        {
+            const auto it = _index.find(key);
+            if (it == _index.end())
+            {
+                return;
+            }
+            _totalCost -= it->second->cost;
+            _entries.erase(it->second);
+            _index.erase(it);
+        }
+
+        void clear()
+        {
+            _entries.clear();
+            _index.clear();
+            _totalCost = 0;
+        }
+
+        std::size_t size() const
+        {
+            return _entries.size();
+        }
+
+        std::size_t totalCost() const
+        {
+            return _totalCost;
+        }
+
+    private:
+        struct Entry
+        {
+            std::string key;
+            Value value;
+            std::size_t cost;
+        };
+
+        void evict()
+        {
+            while (_totalCost > _capacity && !_entries.empty())
+            {
+                const Entry &oldest = _entries.back();
+                _totalCost -= oldest.cost;
+                _index.erase(oldest.key);
+                _entries.pop_back();
+            }
+        }
+
+        std::size_t _capacity;
+        std::size_t _totalCost = 0;
+        std::list<Entry> _entries;
+        std::unordered_map<std::string, typename std::list<Entry>::iterator> _index;
+    };
+}
@@ -0,0 +1,116 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace deepgram
+{
+    /**
+     * Read-only memory mapping of a whole file. The pages are served straight
+     * from the OS page cache, so repeatedly replaying a file costs no read()
+     * calls and no heap copies. An empty or missing file yields a null map.
+     */
+    class MappedFile
+    {
+    public:
+        static std::shared_ptr<MappedFile> open(const std::string &path)
+        {
+            std::shared_ptr<MappedFile> file(new MappedFile());
+#ifdef _WIN32
+            HANDLE handle = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_DELETE, nullptr,
+                                        OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+            if (handle == INVALID_HANDLE_VALUE)
+            {
+                return nullptr;
+            }
+            LARGE_INTEGER size;
+            if (!GetFileSizeEx(handle, &size) || size.QuadPart == 0)
+            {
+                CloseHandle(handle);
+                return nullptr;
+            }
+            HANDLE mapping = CreateFileMappingA(handle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+            CloseHandle(handle);
+            if (!mapping)
+            {
+                return nullptr;
+            }
+            void *view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+            CloseHandle(mapping);
+            if (!view)
+            {
+                return nullptr;
+            }
+            file->_data = static_cast<const std::uint8_t *>(view);
+            file->_size = static_cast<std::size_t>(size.QuadPart);
+#else
+            const int fd = ::open(path.c_str(), O_RDONLY);
+            if (fd < 0)
+            {
+                return nullptr;
+            }
+            struct stat st;
+            if (::fstat(fd, &st) != 0 || st.st_size <= 0)
+            {
+                ::close(fd);
+                return nullptr;
+            }
+            void *view = ::mmap(nullptr, static_cast<std::size_t>(st.st_size), PROT_READ, MAP_SHARED, fd, 0);
+            ::close(fd);
+            if (view == MAP_FAILED)
+            {
+                return nullptr;
+            }
+            file->_data = static_cast<const std::uint8_t *>(view);
+            file->_size = static_cast<std::size_t>(st.st_size);
+#endif
+            return file;
+        }
+
+        ~MappedFile()
+        {
+            if (!_data)
+            {
+                return;
+            }
+#ifdef _WIN32
+            UnmapViewOfFile(_data);
+#else
+            ::munmap(const_cast<std::uint8_t *>(_data), _size);
+#endif
+        }
+
+        MappedFile(const MappedFile &) = delete;
+        MappedFile &operator=(const MappedFile &) = delete;
+
+        const std::uint8_t *data() const
+        {
+            return _data;
+        }
+
+        std::size_t size() const
+        {
+            return _size;
+        }
+
+    private:
+        MappedFile() = default;
+
+        const std::uint8_t *_data = nullptr;
+        std::size_t _size = 0;
+    };
+}
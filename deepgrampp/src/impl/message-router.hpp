@@ -0,0 +1,188 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace deepgram
+{
+    /**
+     * Returns the value of the top-level "type" key of a JSON object without
+     * building a DOM. Nested objects and arrays are skipped by bracket
+     * counting, so the cost is a single forward scan that usually stops after
+     * the first key. Returns nullopt if the text isn't an object or has no
+     * top-level string "type". Malformed input never reads out of bounds; it
+     * simply yields nullopt or a value no route matches, and the decoder that
+     * runs afterwards reports the actual error.
+     */
+    inline std::optional<std::string_view> peekMessageType(std::string_view json)
+    {
+        std::size_t i = 0;
+        const std::size_t n = json.size();
+        const auto skipWhitespace = [&]()
+        {
+            while (i < n && (json[i] == ' ' || json[i] == '\t' || json[i] == '\n' || json[i] == '\r'))
+            {
+                ++i;
+            }
+        };
+        // Expects json[i] == '"'; returns the raw contents and leaves i past the closing quote.
+        const auto readString = [&]() -> std::string_view
+        {
+            const std::size_t begin = ++i;
+            while (i < n && json[i] != '"')
+            {
+                i += json[i] == '\\' ? 2 : 1;
+            }
+            const std::string_view contents = json.substr(begin, std::min(i, n) - begin);
+            ++i;
+            return contents;
+        };
+        const auto skipValue = [&]()
+        {
+            if (i < n && json[i] == '"')
+            {
+                readString();
+                return;
+            }
+            int depth = 0;
+            while (i < n)
+            {
+                const char c = json[i];
+                if (c == '"')
+                {
+                    readString();
+                    continue;
+                }
+                if (c == '{' || c == '[')
+                {
+                    ++depth;
+                }
+                else if (c == '}' || c == ']')
+                {
+                    if (depth == 0)
+                    {
+                        return;
+                    }
+                    --depth;
+                }
+                else if (c == ',' && depth == 0)
+                {
+                    return;
+                }
+                ++i;
+            }
+        };
+
+        skipWhitespace();
+        if (i >= n || json[i] != '{')
+        {
+            return std::nullopt;
+        }
+        ++i;
+        for (;;)
+        {
+            skipWhitespace();
+            if (i >= n || json[i] != '"')
+            {
+                return std::nullopt;
+            }
+            const std::string_view key = readString();
+            skipWhitespace();
+            if (i >= n || json[i] != ':')
+            {
+                return std::nullopt;
+            }
+            ++i;
+            skipWhitespace();
+            if (key == "type")
+            {
+                if (i < n && json[i] == '"')
+                {
+                    return readString();
+                }
+                return std::nullopt;
+            }
+            skipValue();
+            skipWhitespace();
+            if (i >= n || json[i] != ',')
+            {
+                return std::nullopt;
+            }
+            ++i;
+        }
+    }
+
+    /**
+     * Dispatches raw server messages on their top-level "type" so that each
+     * message is decoded exactly once, by the decoder of its type, and only if
+     * someone is listening for it.
+     */
+    class MessageRouter
+    {
+    public:
+        using Route = std::function<void(const std::string &message)>;
+        using Fallback = std::function<void(const std::string &message, std::optional<std::string_view> type)>;
+
+        /**
+         * @param wanted Checked before `decode` runs; a type nobody wants costs
+         *        only the peek. Null means always wanted.
+         * @param decode Decodes `message` and invokes the typed callback.
+         */
+        void add(std::string type, std::function<bool()> wanted, Route decode)
+        {
+            _routes.push_back(Entry{std::move(type), std::move(wanted), std::move(decode)});
+        }
+
+        /**
+         * Receives messages whose type has no route, or that have no type.
+         */
+        void setFallback(Fallback fallback)
+        {
+            _fallback = std::move(fallback);
+        }
+
+        /**
+         * Exceptions thrown by decoders propagate to the caller.
+         */
+        void route(const std::string &message) const
+        {
+            const auto type = peekMessageType(message);
+            if (type)
+            {
+                // A handful of routes per client: a linear scan beats hashing.
+                for (const auto &entry : _routes)
+                {
+                    if (entry.type == *type)
+                    {
+                        if (!entry.wanted || entry.wanted())
+                        {
+                            entry.decode(message);
+                        }
+                        return;
+                    }
+                }
+            }
+            if (_fallback)
+            {
+                _fallback(message, type);
+            }
+        }
+
+    private:
+        struct Entry
+        {
+            std::string type;
+            std::function<bool()> wanted;
+            Route decode;
+        };
+
+        std::vector<Entry> _routes;
+        Fallback _fallback;
+    };
+}
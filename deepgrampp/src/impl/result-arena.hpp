@@ -0,0 +1,117 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <optional>
+
+namespace deepgram
+{
+    /**
+     * Per-session bump allocator for decoded messages. Everything allocated
+     * while handling one message is dropped at once by reset(); nothing is
+     * freed piecemeal. The arena starts with a fixed block and, whenever a
+     * message didn't fit, grows that block on the next reset so the steady
+     * state never reaches the global heap (and never contends on its locks
+     * with other sessions).
+     *
+     * Not thread-safe: one arena per receive thread.
+     */
+    class ResultArena
+    {
+    public:
+        static constexpr std::size_t kDefaultBlockBytes = 16 * 1024;
+        static constexpr std::size_t kMaxBlockBytes = 1024 * 1024;
+
+        /**
+         * Resets the arena when it goes out of scope. Declare it before the
+         * objects allocated from the arena so those are destroyed first.
+         */
+        class Lease
+        {
+        public:
+            explicit Lease(ResultArena &arena) : _arena(arena) {}
+            ~Lease() { _arena.reset(); }
+            Lease(const Lease &) = delete;
+            Lease &operator=(const Lease &) = delete;
+
+        private:
+            ResultArena &_arena;
+        };
+
+        explicit ResultArena(std::size_t blockBytes = kDefaultBlockBytes)
+        {
+            allocateBlock(blockBytes);
+        }
+
+        ResultArena(const ResultArena &) = delete;
+        ResultArena &operator=(const ResultArena &) = delete;
+
+        std::pmr::memory_resource *resource()
+        {
+            return &*_resource;
+        }
+
+        void reset()
+        {
+            _resource.reset();
+            const std::size_t overflow = _upstream.takeAllocatedBytes();
+            if (overflow > 0 && _blockBytes < kMaxBlockBytes)
+            {
+                allocateBlock(std::min(kMaxBlockBytes, std::max(_blockBytes * 2, _blockBytes + overflow)));
+                return;
+            }
+            _resource.emplace(_block.get(), _blockBytes, &_upstream);
+        }
+
+        std::size_t blockBytes() const
+        {
+            return _blockBytes;
+        }
+
+    private:
+        // Forwards to the heap and records how much the block was short by.
+        class OverflowResource : public std::pmr::memory_resource
+        {
+        public:
+            std::size_t takeAllocatedBytes()
+            {
+                const std::size_t bytes = _allocatedBytes;
+                _allocatedBytes = 0;
+                return bytes;
+            }
+
+        private:
+            void *do_allocate(std::size_t bytes, std::size_t alignment) override
+            {
+                _allocatedBytes += bytes;
+                return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+            }
+
+            void do_deallocate(void *p, std::size_t bytes, std::size_t alignment) override
+            {
+                std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+            }
+
+            bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override
+            {
+                return this == &other;
+            }
+
+            std::size_t _allocatedBytes = 0;
+        };
+
+        void allocateBlock(std::size_t bytes)
+        {
+            _block = std::make_unique<std::byte[]>(bytes);
+            _blockBytes = bytes;
+            _resource.emplace(_block.get(), _blockBytes, &_upstream);
+        }
+
+        OverflowResource _upstream;
+        std::unique_ptr<std::byte[]> _block;
+        std::size_t _blockBytes = 0;
+        std::optional<std::pmr::monotonic_buffer_resource> _resource;
+    };
+}
@@ -0,0 +1,251 @@
+#pragma once
+
+#include "../../include/deepgrampp/rate-limiter.hpp"
+#include "../../include/deepgrampp/retry-policy.hpp"
+#include "../../include/deepgrampp/transport/http_transport.hpp"
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+namespace deepgram
+{
+    /**
+     * Wraps an IHttpTransport with a RetryPolicy: retries, backoff and optional
+     * hedging. Shared by the REST client impls so they only ever deal with the
+     * final outcome of a request.
+     */
+    class RetryingHttpSender
+    {
+    public:
+        explicit RetryingHttpSender(std::shared_ptr<transport::IHttpTransport> httpTransport)
+            : _httpTransport(std::move(httpTransport))
+        {
+        }
+
+        /**
+         * Not synchronized with in-flight send() calls; set it up before issuing
+         * requests.
+         */
+        void setPolicy(const RetryPolicy &policy)
+        {
+            _policy = policy;
+        }
+
+        const RetryPolicy &policy() const
+        {
+            return _policy;
+        }
+
+        /**
+         * Every attempt (retries and hedges included) then takes a request
+         * permit for as long as it is in flight. Same caveat as setPolicy().
+         */
+        void setRateLimiter(std::shared_ptr<RateLimiter> rateLimiter)
+        {
+            _rateLimiter = std::move(rateLimiter);
+        }
+
+        /**
+         * Same contract as IHttpTransport::send(): returns the last response
+         * (whatever its status) once it is either successful, not retryable, or
+         * the attempts are exhausted; rethrows the last transport error if the
+         * final attempt threw.
+         */
+        transport::HttpResponse send(const transport::HttpRequest &request)
+        {
+            const auto shared = std::make_shared<const transport::HttpRequest>(request);
+            const int maxAttempts = std::max(1, _policy.maxAttempts);
+
+            for (int attempt = 1;; ++attempt)
+            {
+                std::optional<std::chrono::milliseconds> retryAfter;
+                try
+                {
+                    transport::HttpResponse response = sendOnce(shared);
+                    if (attempt >= maxAttempts || !_policy.isRetryableStatus(response.status_code))
+                    {
+                        return response;
+                    }
+                    retryAfter = parseRetryAfter(response);
+                    if (retryAfter && *retryAfter > _policy.maxRetryAfter)
+                    {
+                        spdlog::warn("{} returned HTTP {} with Retry-After {} s, beyond RetryPolicy::maxRetryAfter; not retrying",
+                                     request.url, response.status_code, retryAfter->count() / 1000);
+                        return response;
+                    }
+                    spdlog::warn("{} returned HTTP {}, retrying (attempt {}/{})",
+                                 request.url, response.status_code, attempt + 1, maxAttempts);
+                }
+                catch (const std::exception &e)
+                {
+                    if (attempt >= maxAttempts || !_policy.retryOnTransportError)
+                    {
+                        throw;
+                    }
+                    spdlog::warn("{} failed: {}, retrying (attempt {}/{})",
+                                 request.url, e.what(), attempt + 1, maxAttempts);
+                }
+                std::this_thread::sleep_for(retryAfter ? *retryAfter : backoffFor(attempt));
+            }
+        }
+
+    private:
+        /**
+         * State shared between a hedged request's attempts, which may outlive
+         * the send() call that started them.
+         */
+        struct HedgeRace
+        {
+            std::mutex mutex;
+            std::condition_variable cv;
+            int running = 0;
+            // Set by the first reply the outer loop wouldn't retry; that ends the race.
+            std::optional<transport::HttpResponse> response;
+            // The latest retryable (5xx/429) reply, returned only if no attempt
+            // still running does better.
+            std::optional<transport::HttpResponse> retryable;
+            std::exception_ptr lastError;
+        };
+
+        transport::HttpResponse sendOnce(const std::shared_ptr<const transport::HttpRequest> &request)
+        {
+            if (!_policy.hedgeAfter)
+            {
+                const auto permit = _rateLimiter ? _rateLimiter->acquireRequest() : RateLimiter::Permit{};
+                return _httpTransport->send(*request);
+            }
+
+            auto race = std::make_shared<HedgeRace>();
+            launchHedgeAttempt(race, request);
+
+            std::unique_lock<std::mutex> lk(race->mutex);
+            const bool settled = race->cv.wait_for(lk, *_policy.hedgeAfter, [&race]
+                                                   { return race->response.has_value() || race->running == 0; });
+            if (!settled)
+            {
+                spdlog::debug("{} still pending after {} ms, hedging", request->url, _policy.hedgeAfter->count());
+                lk.unlock();
+                launchHedgeAttempt(race, request);
+                lk.lock();
+            }
+            race->cv.wait(lk, [&race]
+                          { return race->response.has_value() || race->running == 0; });
+
+            if (race->response)
+            {
+                return *race->response;
+            }
+            if (race->retryable)
+            {
+                return *race->retryable;
+            }
+            std::rethrow_exception(race->lastError);
+        }
+
+        void launchHedgeAttempt(const std::shared_ptr<HedgeRace> &race,
+                                const std::shared_ptr<const transport::HttpRequest> &request)
+        {
+            {
+                std::lock_guard<std::mutex> lk(race->mutex);
+                ++race->running;
+            }
+            // Detached on purpose: the losing attempt can't be cancelled through
+            // IHttpTransport, so it finishes on its own and its result is dropped.
+            std::thread([race, request, httpTransport = _httpTransport, rateLimiter = _rateLimiter, policy = _policy]()
+                        {
+                std::optional<transport::HttpResponse> response;
+                std::exception_ptr error;
+                try
+                {
+                    const auto permit = rateLimiter ? rateLimiter->acquireRequest() : RateLimiter::Permit{};
+                    response = httpTransport->send(*request);
+                }
+                catch (...)
+                {
+                    error = std::current_exception();
+                }
+                {
+                    std::lock_guard<std::mutex> lk(race->mutex);
+                    --race->running;
+                    if (response && !race->response)
+                    {
+                        if (policy.isRetryableStatus(response->status_code))
+                        {
+                            race->retryable = std::move(response);
+                        }
+                        else
+                        {
+                            race->response = std::move(response);
+                        }
+                    }
+                    else if (error)
+                    {
+                        race->lastError = error;
+                    }
+                }
+                race->cv.notify_all(); })
+                .detach();
+        }
+
+        std::chrono::milliseconds backoffFor(int attempt) const
+        {
+            double delay = static_cast<double>(_policy.initialBackoff.count());
+            for (int i = 1; i < attempt; ++i)
+            {
+                delay *= _policy.backoffMultiplier;
+            }
+            delay = std::min(delay, static_cast<double>(_policy.maxBackoff.count()));
+
+            thread_local std::mt19937 rng{std::random_device{}()};
+            const double jitter = std::clamp(_policy.jitter, 0.0, 1.0);
+            std::uniform_real_distribution<double> dist(1.0 - jitter, 1.0);
+            return std::chrono::milliseconds(static_cast<long long>(delay * dist(rng)));
+        }
+
+        std::optional<std::chrono::milliseconds> parseRetryAfter(const transport::HttpResponse &response) const
+        {
+            if (!_policy.respectRetryAfter)
+            {
+                return std::nullopt;
+            }
+            const auto it = response.headers.find("retry-after");
+            if (it == response.headers.end())
+            {
+                return std::nullopt;
+            }
+            // Only the delta-seconds form is understood; an HTTP-date falls back
+            // to the regular backoff.
+            try
+            {
+                std::size_t consumed = 0;
+                const long seconds = std::stol(it->second, &consumed);
+                if (consumed != it->second.size() || seconds < 0)
+                {
+                    return std::nullopt;
+                }
+                // Clamped to a year only so the conversion can't overflow.
+                constexpr long kMaxSeconds = 365L * 24 * 3600;
+                return std::chrono::milliseconds(static_cast<long long>(std::min(seconds, kMaxSeconds)) * 1000);
+            }
+            catch (const std::exception &)
+            {
+                return std::nullopt;
+            }
+        }
+
+        std::shared_ptr<transport::IHttpTransport> _httpTransport;
+        std::shared_ptr<RateLimiter> _rateLimiter;
+        RetryPolicy _policy;
+    };
+}
@@ -2,6 +2,7 @@
 
 #include "../../include/deepgrampp/speak-rest.hpp"
 #include "../../include/deepgrampp/transport/curl_http_transport.hpp"
+#include "retrying-http-sender.hpp"
 
 #include <nlohmann/json.hpp>
 #include <spdlog/spdlog.h>
@@ -21,12 +22,54 @@ namespace deepgram
                                  std::shared_ptr<transport::IHttpTransport> httpTransport,
                                  const std::string &caFilePath = {})
                 : _host(host), _apiKey(apiKey),
-                  _httpTransport(httpTransport ? std::move(httpTransport)
-                                                : std::make_shared<transport::CurlHttpTransport>(caFilePath))
+                  _httpSender(httpTransport ? std::move(httpTransport)
+                                             : std::make_shared<transport::CurlHttpTransport>(caFilePath))
             {
             }
 
+            void setRetryPolicy(const RetryPolicy &policy)
+            {
+                _httpSender.setPolicy(policy);
+            }
+
+            void setRateLimiter(std::shared_ptr<RateLimiter> rateLimiter)
+            {
+                _httpSender.setRateLimiter(std::move(rateLimiter));
+            }
+
+            void setSpeechCache(std::shared_ptr<SpeechCache> cache)
+            {
+                _speechCache = std::move(cache);
+            }
+
             SpeakRestResult speak(const std::string &text, const LiveSpeakConfig &config)
+            {
+                if (!_speechCache)
+                {
+                    return send(text, config);
+                }
+                const std::string key = SpeechCache::makeKey(text, config, SpeechSource::Rest);
+                if (const auto cached = _speechCache->get(key))
+                {
+                    SpeakRestResult result;
+                    result.success = true;
+                    result.statusCode = 200;
+                    result.fromCache = true;
+                    result.audio.assign(cached->data(), cached->data() + cached->size());
+                    result.contentType = cached->contentType();
+                    result.modelName = config.model;
+                    return result;
+                }
+                SpeakRestResult result = send(text, config);
+                if (result.success)
+                {
+                    _speechCache->put(key, result.audio, result.contentType);
+                }
+                return result;
+            }
+
+        private:
+            SpeakRestResult send(const std::string &text, const LiveSpeakConfig &config)
             {
                 transport::HttpRequest request;
                 request.method = transport::HttpMethod::Post;
@@ -39,7 +82,7 @@ namespace deepgram
                 transport::HttpResponse response;
                 try
                 {
-                    response = _httpTransport->send(request);
+                    response = _httpSender.send(request);
                 }
                 catch (const std::exception &e)
                 {
@@ -77,10 +120,10 @@ namespace deepgram
                 return result;
             }
 
-        private:
             std::string _host;
             std::string _apiKey;
-            std::shared_ptr<transport::IHttpTransport> _httpTransport;
+            RetryingHttpSender _httpSender;
+            std::shared_ptr<SpeechCache> _speechCache;
         };
     }
 }
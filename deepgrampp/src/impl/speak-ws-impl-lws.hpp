@@ -1,16 +1,25 @@
 #pragma once
 
 #include "../../include/deepgrampp/speak-ws.hpp"
+#include "../../include/deepgrampp/audio/g711.hpp"
 #include "../../include/deepgrampp/transport/lws_websocket_transport.hpp"
+#include "close-latch.hpp"
+#include "json-writer.hpp"
+#include "message-router.hpp"
+#include "stream-slot.hpp"
+#include "timer-wheel.hpp"
 
 #include <spdlog/spdlog.h>
 
+#include <algorithm>
 #include <atomic>
 #include <chrono>
 #include <cstdint>
 #include <functional>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <string_view>
 #include <thread>
 #include <vector>
 
@@ -64,59 +73,166 @@ namespace deepgram
                               std::function<void(const std::string &)> onText,
                               std::function<void(const std::string &)> onError,
                               std::function<void()> onDisconnected,
-                              std::function<void()> onSpeechStarted)
+                              std::function<void()> onSpeechStarted,
+                              std::function<void()> onSpeechEnded)
             {
-                _wsTransport->setOnBinaryMessage([this, onAudio, onSpeechStarted](const std::vector<std::uint8_t> &data)
+                _onAudio = std::move(onAudio);
+                _onSpeechStarted = std::move(onSpeechStarted);
+                _onSpeechEnded = std::move(onSpeechEnded);
+                _wsTransport->setOnBinaryMessage([this](const std::vector<std::uint8_t> &data)
                                                  {
-                    if (!_receivingSpeech.exchange(true))
+                    captureAudio(data.data(), data.size());
+                    deliverAudio(data.data(), data.size()); });
+                _wsTransport->setOnTextMessage(std::move(onText));
+                _wsTransport->setOnError(std::move(onError));
+                _wsTransport->setOnClose([this, onDisconnected]()
+                                         {
+                    _streamSlot.release();
+                    if (onDisconnected) onDisconnected();
+                    _closeLatch.signal(); });
+            }
+
+            void setCloseTimeout(std::chrono::milliseconds timeout)
+            {
+                _closeTimeout = timeout;
+            }
+
+            void setRateLimiter(std::shared_ptr<RateLimiter> rateLimiter)
+            {
+                _streamSlot.setRateLimiter(std::move(rateLimiter));
+            }
+
+            MessageRouter &router()
+            {
+                return _router;
+            }
+
+            void setDecodeToLinear16(bool decode)
+            {
+                _decodeToLinear16.store(decode);
+            }
+
+            void setSpeechCache(std::shared_ptr<SpeechCache> cache)
+            {
+                std::lock_guard<std::mutex> lk(_cacheMutex);
+                _speechCache = std::move(cache);
+                resetCapture();
+            }
+
+            /**
+             * Sends `text` for synthesis, or replays it from the speech cache.
+             *
+             * A cached text is only replayed when no text sent to the server is
+             * still waiting for its audio; otherwise its audio would overtake the
+             * earlier text's, so it is synthesized (and re-cached) normally.
+             */
+            bool speak(const std::string &text)
+            {
+                std::shared_ptr<const CachedSpeech> cached;
+                {
+                    std::lock_guard<std::mutex> lk(_cacheMutex);
+                    if (_speechCache && _pendingTexts.empty())
                     {
-                        if (onSpeechStarted) onSpeechStarted();
+                        cached = _speechCache->get(SpeechCache::makeKey(text, _config, SpeechSource::Websocket));
                     }
-                    if (onAudio)
+                    if (!cached && _speechCache)
                     {
-                        onAudio(reinterpret_cast<const char *>(data.data()), static_cast<int>(data.size()));
+                        _pendingTexts.push_back(text);
+                        ++_unflushedTexts;
                     }
-                    _lastSpeechMessageTime.store(nowMs()); });
-                _wsTransport->setOnTextMessage(std::move(onText));
-                _wsTransport->setOnError(std::move(onError));
-                _wsTransport->setOnClose(std::move(onDisconnected));
+                }
+                if (cached)
+                {
+                    spdlog::debug("Replaying {} cached audio bytes", cached->size());
+                    replay(*cached);
+                    // Nothing is on its way from the server, so the replay was all of it.
+                    if (speechDrained())
+                    {
+                        endSpeech();
+                    }
+                    return true;
+                }
+                {
+                    std::lock_guard<std::mutex> lk(_speechMutex);
+                    ++_speechTextsUnflushed;
+                }
+                // Escaped straight into a per-session frame buffer that keeps its
+                // capacity: one pass per text fragment, no DOM, no temporaries.
+                std::lock_guard<std::mutex> lk(_frameMutex);
+                writeSpeakMessage(_speakFrame, text);
+                return sendPayload(_speakFrame);
+            }
+
+            bool flush()
+            {
+                {
+                    std::lock_guard<std::mutex> lk(_speechMutex);
+                    ++_speechFlushesPending;
+                    _speechTextsUnflushed = 0;
+                }
+                {
+                    std::lock_guard<std::mutex> lk(_cacheMutex);
+                    if (_unflushedTexts > 0)
+                    {
+                        _unflushedTexts = 0;
+                        ++_flushesInFlight;
+                    }
+                }
+                return sendPayload(control::FLUSH);
+            }
+
+            bool clear()
+            {
+                {
+                    std::lock_guard<std::mutex> lk(_cacheMutex);
+                    resetCapture();
+                }
+                return sendPayload(control::CLEAR);
             }
 
             /**
-             * Starts the background monitor that infers end-of-speech from a gap in
-             * binary audio frames (Deepgram does not send an explicit "speech ended"
-             * event). Must be started only once the connection is open.
+             * Fed "Flushed" and "Cleared" responses. The server sends Flushed
+             * after the last audio frame of everything sent before the Flush, so
+             * once every Flush has been answered and no text was sent since,
+             * speech has ended -- no need to wait for the reception timeout.
+             *
+             * Also, once the server has flushed everything sent since the
+             * connection was last idle, the captured audio is stored -- but only
+             * if it all belongs to a single text, since the server doesn't say
+             * where one text's audio ends and the next begins.
              */
-            void startSpeechTimeoutMonitor(std::function<void()> onSpeechEnded)
+            void onControlResponse(const std::string &type)
             {
-                _timeoutThread = std::thread([this, onSpeechEnded]()
-                                             {
-                    try
+                if (type == "Cleared")
+                {
                     {
-                        while (_wsTransport->isOpen())
-                        {
-                            if (_receivingSpeech.load())
-                            {
-                                uint64_t currentTime = nowMs();
-                                uint64_t lastTime = _lastSpeechMessageTime.load();
-                                if (currentTime - lastTime > static_cast<uint64_t>(_speechReceptionTimeoutMs))
-                                {
-                                    spdlog::debug("No speech data received for {} milliseconds, assuming end of speech.", _speechReceptionTimeoutMs);
-                                    _receivingSpeech.store(false);
-                                    if (onSpeechEnded) onSpeechEnded();
-                                }
-                            }
-                            std::this_thread::sleep_for(std::chrono::milliseconds(500));
-                        }
+                        std::lock_guard<std::mutex> lk(_speechMutex);
+                        _speechFlushesPending = 0;
+                        _speechTextsUnflushed = 0;
                     }
-                    catch (const std::exception &e)
-                    {
-                        spdlog::error("Exception in timeout thread: {}", e.what());
-                    } });
+                    endSpeech();
+                    return;
+                }
+                if (type != "Flushed")
+                {
+                    return;
+                }
+                bool drained;
+                {
+                    std::lock_guard<std::mutex> lk(_speechMutex);
+                    _speechFlushesPending = std::max(0, _speechFlushesPending - 1);
+                    drained = _speechFlushesPending == 0 && _speechTextsUnflushed == 0;
+                }
+                storeFlushedCapture();
+                if (drained)
+                {
+                    endSpeech();
+                }
             }
 
             bool connect(const LiveSpeakConfig &config)
             {
+                RateLimiter::Permit permit = _streamSlot.acquire();
                 try
                 {
                     transport::WebSocketConnectOptions wsOptions;
@@ -125,7 +241,23 @@ namespace deepgram
                     wsOptions.headers["User-Agent"] = "DeepgramCppClient/1.0";
 
                     spdlog::debug("Connecting to {} ...", wsOptions.url);
+                    _closeLatch.arm();
                     _wsTransport->connect(wsOptions);
+                    _streamSlot.hold(std::move(permit));
+                    {
+                        std::lock_guard<std::mutex> lk(_cacheMutex);
+                        _config = config;
+                        resetCapture();
+                    }
+                    // Only bare G.711 samples can be decoded: a container
+                    // (wav) puts a header in front of them.
+                    const bool bare = !config.container || config.container.value() == "none";
+                    _speechFormat.store(bare ? audio::wireFormat(config.encoding, 0, 1).sampleFormat : audio::SampleFormat::Encoded);
+                    {
+                        std::lock_guard<std::mutex> lk(_speechMutex);
+                        _speechFlushesPending = 0;
+                        _speechTextsUnflushed = 0;
+                    }
                     spdlog::debug("WebSocket connected successfully!");
                     return true;
                 }
@@ -136,7 +268,7 @@ namespace deepgram
                 }
             }
 
-            bool sendPayload(const std::string &payload)
+            bool sendPayload(std::string_view payload)
             {
                 if (!_wsTransport->isOpen())
                 {
@@ -145,7 +277,7 @@ namespace deepgram
                 }
                 try
                 {
-                    _wsTransport->sendText(payload);
+                    _wsTransport->sendText(payload.data(), payload.size());
                     return true;
                 }
                 catch (const std::exception &e)
@@ -157,7 +289,7 @@ namespace deepgram
 
             bool sendCloseStream()
             {
-                return sendPayload(std::string(control::CLOSE));
+                return sendPayload(control::CLOSE);
             }
 
             void close()
@@ -166,26 +298,164 @@ namespace deepgram
                 {
                     spdlog::debug("Closing connection...");
 
-                    sendCloseStream();
-                    // Wait a moment for final messages
-                    std::this_thread::sleep_for(std::chrono::milliseconds(500));
+                    // The server sends the remaining audio, then closes the socket.
+                    if (sendCloseStream() && !_closeLatch.wait(_closeTimeout))
+                    {
+                        spdlog::warn("server didn't close within {} ms of Close, closing anyway", _closeTimeout.count());
+                    }
 
                     _wsTransport->close();
                 }
 
-                // The timeout monitor thread's own loop exits once isOpen() goes
-                // false (whether that happened here or the socket was already
-                // closed, e.g. by the server), so it must always be joined here --
-                // otherwise a joinable std::thread left in the destructor calls
-                // std::terminate().
-                if (_timeoutThread.joinable())
+                const TimerWheel::TimerId speechTimer = _speechTimer.exchange(0);
+                if (speechTimer != 0)
                 {
-                    _timeoutThread.join();
+                    TimerWheel::shared().cancel(speechTimer);
                 }
+                _speechTimerArmed.store(false);
+                _receivingSpeech.store(false);
+                _streamSlot.release();
                 spdlog::debug("Connection closed.");
             }
 
         private:
+            void storeFlushedCapture()
+            {
+                std::lock_guard<std::mutex> lk(_cacheMutex);
+                if (_flushesInFlight == 0 || --_flushesInFlight > 0 || _unflushedTexts > 0)
+                {
+                    return;
+                }
+                if (_pendingTexts.size() == 1 && !_capturedAudio.empty())
+                {
+                    _speechCache->put(SpeechCache::makeKey(_pendingTexts.front(), _config, SpeechSource::Websocket), std::move(_capturedAudio),
+                                      SpeechCache::streamContentType(_config));
+                }
+                resetCapture();
+            }
+
+            void deliverAudio(const std::uint8_t *data, std::size_t size)
+            {
+                _lastSpeechMessageTime.store(nowMs());
+                if (!_receivingSpeech.exchange(true))
+                {
+                    if (_onSpeechStarted) _onSpeechStarted();
+                    armSpeechTimer();
+                }
+                if (!_onAudio)
+                {
+                    return;
+                }
+                const audio::SampleFormat format = _speechFormat.load();
+                if (!_decodeToLinear16.load() || (format != audio::SampleFormat::Mulaw && format != audio::SampleFormat::Alaw))
+                {
+                    _onAudio(reinterpret_cast<const char *>(data), static_cast<int>(size));
+                    return;
+                }
+                // G.711 is one byte per sample, so there's nothing to carry
+                // between messages; decode in blocks that fit on the stack.
+                constexpr std::size_t blockSamples = 4096;
+                std::int16_t block[blockSamples];
+                for (std::size_t offset = 0; offset < size; offset += blockSamples)
+                {
+                    const std::size_t count = std::min(blockSamples, size - offset);
+                    if (format == audio::SampleFormat::Mulaw)
+                    {
+                        audio::mulawDecode(data + offset, block, count);
+                    }
+                    else
+                    {
+                        audio::alawDecode(data + offset, block, count);
+                    }
+                    _onAudio(reinterpret_cast<const char *>(block), static_cast<int>(count * sizeof(std::int16_t)));
+                }
+            }
+
+            void endSpeech()
+            {
+                if (_receivingSpeech.exchange(false))
+                {
+                    if (_onSpeechEnded) _onSpeechEnded();
+                }
+            }
+
+            bool speechDrained()
+            {
+                std::lock_guard<std::mutex> lk(_speechMutex);
+                return _speechFlushesPending == 0 && _speechTextsUnflushed == 0;
+            }
+
+            /**
+             * Fallback for speech that is never flushed: a one-shot timer on the
+             * shared TimerWheel, due `_speechReceptionTimeoutMs` after the last
+             * audio frame. While frames keep arriving it re-arms itself for the
+             * remaining time instead of being rescheduled per frame.
+             */
+            void armSpeechTimer()
+            {
+                if (!_speechTimerArmed.exchange(true))
+                {
+                    _speechTimer.store(TimerWheel::shared().schedule(std::chrono::milliseconds(_speechReceptionTimeoutMs), [this]()
+                                                                     { return onSpeechTimer(); }));
+                }
+            }
+
+            std::chrono::milliseconds onSpeechTimer()
+            {
+                for (;;)
+                {
+                    if (_receivingSpeech.load())
+                    {
+                        const uint64_t idleMs = nowMs() - _lastSpeechMessageTime.load();
+                        if (idleMs < static_cast<uint64_t>(_speechReceptionTimeoutMs))
+                        {
+                            return std::chrono::milliseconds(_speechReceptionTimeoutMs - static_cast<int>(idleMs));
+                        }
+                        spdlog::debug("No speech data received for {} milliseconds, assuming end of speech.", _speechReceptionTimeoutMs);
+                        endSpeech();
+                    }
+                    _speechTimerArmed.store(false);
+                    // Speech that started meanwhile saw the timer still armed and
+                    // didn't arm another one, so this one keeps serving it.
+                    if (!_receivingSpeech.load() || _speechTimerArmed.exchange(true))
+                    {
+                        return std::chrono::milliseconds(0);
+                    }
+                }
+            }
+
+            /**
+             * Hands cached audio to the result callback in frame-sized chunks, as
+             * fast as the callback consumes them -- the same shape the server's
+             * binary messages have, just without the network round trip.
+             */
+            void replay(const CachedSpeech &speech)
+            {
+                constexpr std::size_t chunkSize = 16 * 1024;
+                for (std::size_t offset = 0; offset < speech.size(); offset += chunkSize)
+                {
+                    deliverAudio(speech.data() + offset, std::min(chunkSize, speech.size() - offset));
+                }
+            }
+
+            void captureAudio(const std::uint8_t *data, std::size_t size)
+            {
+                std::lock_guard<std::mutex> lk(_cacheMutex);
+                if (_pendingTexts.size() == 1)
+                {
+                    _capturedAudio.insert(_capturedAudio.end(), data, data + size);
+                }
+            }
+
+            // Called with _cacheMutex held.
+            void resetCapture()
+            {
+                _pendingTexts.clear();
+                _unflushedTexts = 0;
+                _flushesInFlight = 0;
+                _capturedAudio.clear();
+            }
+
             static uint64_t nowMs()
             {
                 return std::chrono::duration_cast<std::chrono::milliseconds>(
@@ -196,10 +466,36 @@ namespace deepgram
             std::string _host;
             std::string _apiKey;
             std::shared_ptr<transport::IWebSocketTransport> _wsTransport;
-            std::thread _timeoutThread;
+            StreamSlot _streamSlot;
+            MessageRouter _router;
             std::atomic<bool> _receivingSpeech{false};
             std::atomic<uint64_t> _lastSpeechMessageTime{0};
             int _speechReceptionTimeoutMs = 500;
+            std::function<void(const char *, int)> _onAudio;
+            std::function<void()> _onSpeechStarted;
+            std::function<void()> _onSpeechEnded;
+            std::atomic<bool> _decodeToLinear16{false};
+            std::atomic<audio::SampleFormat> _speechFormat{audio::SampleFormat::Encoded};
+            std::atomic<bool> _speechTimerArmed{false};
+            std::atomic<TimerWheel::TimerId> _speechTimer{0};
+
+            // End-of-speech tracking from Flushed responses.
+            std::mutex _speechMutex;
+            int _speechFlushesPending = 0;
+            int _speechTextsUnflushed = 0;
+            CloseLatch _closeLatch;
+            std::chrono::milliseconds _closeTimeout{CloseLatch::kDefaultTimeout};
+
+            std::mutex _frameMutex;
+            std::string _speakFrame;
+
+            std::mutex _cacheMutex;
+            std::shared_ptr<SpeechCache> _speechCache;
+            LiveSpeakConfig _config;
+            std::vector<std::string> _pendingTexts; // Sent since the connection was last idle
+            int _unflushedTexts = 0;
+            int _flushesInFlight = 0;
+            std::vector<std::uint8_t> _capturedAudio;
         };
     }
 }
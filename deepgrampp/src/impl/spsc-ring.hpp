@@ -0,0 +1,116 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+
+namespace deepgram
+{
+    /**
+     * Bounded single-producer/single-consumer byte ring. write() and
+     * peek()/consume() are wait-free: each side only loads the other side's
+     * index and publishes its own, with no locks, CAS loops or allocation.
+     *
+     * The indices count bytes monotonically and are masked into a
+     * power-of-two buffer; each sits on its own cache line so the producer
+     * and consumer don't false-share.
+     */
+    class SpscByteRing
+    {
+    public:
+        explicit SpscByteRing(std::size_t capacity = 0)
+        {
+            reset(capacity);
+        }
+
+        SpscByteRing(const SpscByteRing &) = delete;
+        SpscByteRing &operator=(const SpscByteRing &) = delete;
+
+        /**
+         * Discards the contents and reallocates for at least `capacity` bytes
+         * (rounded up to a power of two). Neither side may be active.
+         */
+        void reset(std::size_t capacity)
+        {
+            std::size_t size = 1;
+            while (size < capacity)
+            {
+                size <<= 1;
+            }
+            if (!_buffer || size != _mask + 1)
+            {
+                _buffer = std::make_unique<std::uint8_t[]>(size);
+                _mask = size - 1;
+            }
+            _head.store(0, std::memory_order_relaxed);
+            _tail.store(0, std::memory_order_relaxed);
+        }
+
+        std::size_t capacity() const
+        {
+            return _mask + 1;
+        }
+
+        /**
+         * Bytes currently buffered; exact on the consumer side, a lower
+         * bound on the producer side.
+         */
+        std::size_t size() const
+        {
+            return _head.load(std::memory_order_acquire) - _tail.load(std::memory_order_acquire);
+        }
+
+        /**
+         * Producer: appends all of `data` or, if it doesn't fit, nothing.
+         * All-or-nothing keeps PCM sample frames whole.
+         */
+        bool write(const std::uint8_t *data, std::size_t size)
+        {
+            const std::size_t head = _head.load(std::memory_order_relaxed);
+            const std::size_t tail = _tail.load(std::memory_order_acquire);
+            if (size > capacity() - (head - tail))
+            {
+                return false;
+            }
+            const std::size_t at = head & _mask;
+            const std::size_t first = std::min(size, capacity() - at);
+            std::memcpy(_buffer.get() + at, data, first);
+            std::memcpy(_buffer.get(), data + first, size - first);
+            _head.store(head + size, std::memory_order_release);
+            return true;
+        }
+
+        /**
+         * Consumer: copies up to `size` of the oldest bytes into `out` without
+         * removing them; returns how many were copied.
+         */
+        std::size_t peek(std::uint8_t *out, std::size_t size) const
+        {
+            const std::size_t tail = _tail.load(std::memory_order_relaxed);
+            const std::size_t head = _head.load(std::memory_order_acquire);
+            size = std::min(size, head - tail);
+            const std::size_t at = tail & _mask;
+            const std::size_t first = std::min(size, capacity() - at);
+            std::memcpy(out, _buffer.get() + at, first);
+            std::memcpy(out + first, _buffer.get(), size - first);
+            return size;
+        }
+
+        /**
+         * Consumer: drops `size` bytes previously returned by peek().
+         */
+        void consume(std::size_t size)
+        {
+            _tail.store(_tail.load(std::memory_order_relaxed) + size, std::memory_order_release);
+        }
+
+    private:
+        std::unique_ptr<std::uint8_t[]> _buffer;
+        std::size_t _mask = 0;
+        alignas(64) std::atomic<std::size_t> _head{0};
+        alignas(64) std::atomic<std::size_t> _tail{0};
+    };
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+#include "../../include/deepgrampp/rate-limiter.hpp"
+
+#include <memory>
+#include <mutex>
+
+namespace deepgram
+{
+    /**
+     * Holds the RateLimiter stream permit of a WebSocket session for as long as
+     * the session is open. Shared by the listen/speak/flux impls: acquire()
+     * before connecting, hold() once connected, release() from close() or the
+     * transport's close handler -- whichever happens first.
+     */
+    class StreamSlot
+    {
+    public:
+        void setRateLimiter(std::shared_ptr<RateLimiter> rateLimiter)
+        {
+            std::lock_guard<std::mutex> lk(_mutex);
+            _rateLimiter = std::move(rateLimiter);
+        }
+
+        /**
+         * Blocks until the attached limiter (if any) admits a new stream.
+         */
+        RateLimiter::Permit acquire()
+        {
+            std::shared_ptr<RateLimiter> rateLimiter;
+            {
+                std::lock_guard<std::mutex> lk(_mutex);
+                rateLimiter = _rateLimiter;
+            }
+            return rateLimiter ? rateLimiter->acquireStream() : RateLimiter::Permit{};
+        }
+
+        void hold(RateLimiter::Permit permit)
+        {
+            std::lock_guard<std::mutex> lk(_mutex);
+            _permit = std::move(permit);
+        }
+
+        void release()
+        {
+            RateLimiter::Permit permit;
+            {
+                std::lock_guard<std::mutex> lk(_mutex);
+                permit = std::move(_permit);
+            }
+        }
+
+    private:
+        std::mutex _mutex;
+        std::shared_ptr<RateLimiter> _rateLimiter;
+        RateLimiter::Permit _permit;
+    };
+}
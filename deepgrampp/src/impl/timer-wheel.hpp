@@ -0,0 +1,210 @@
+#pragma once
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace deepgram
+{
+    /**
+     * Hashed timing wheel shared by all sessions of the process: one thread
+     * serves every keepalive and deadline instead of one sleeping thread per
+     * session. Scheduling and cancelling are O(1); the thread sleeps while no
+     * timer is pending and otherwise wakes once per tick.
+     *
+     * Timers fire on the wheel thread, with a resolution of one tick, so tasks
+     * must be short (e.g. enqueue a frame on a transport).
+     */
+    class TimerWheel
+    {
+    public:
+        using TimerId = std::uint64_t;
+        /**
+         * Returns the delay until the timer should fire again, or zero to
+         * retire it.
+         */
+        using Task = std::function<std::chrono::milliseconds()>;
+
+        static constexpr std::chrono::milliseconds kTick{10};
+        static constexpr std::size_t kSlots = 512;
+
+        TimerWheel() : _slots(kSlots) {}
+
+        ~TimerWheel()
+        {
+            {
+                std::lock_guard<std::mutex> lk(_mutex);
+                _stopping = true;
+            }
+            _cv.notify_all();
+            if (_thread.joinable())
+            {
+                _thread.join();
+            }
+        }
+
+        TimerWheel(const TimerWheel &) = delete;
+        TimerWheel &operator=(const TimerWheel &) = delete;
+
+        static TimerWheel &shared()
+        {
+            static TimerWheel wheel;
+            return wheel;
+        }
+
+        TimerId schedule(std::chrono::milliseconds delay, Task task)
+        {
+            std::lock_guard<std::mutex> lk(_mutex);
+            if (!_thread.joinable())
+            {
+                _thread = std::thread([this]()
+                                      { run(); });
+            }
+            const TimerId id = _nextId++;
+            _timers.emplace(id, Timer{std::move(task), 0});
+            place(id, delay);
+            _cv.notify_all();
+            return id;
+        }
+
+        /**
+         * Retires the timer. Once this returns its task is not running and
+         * won't run again, unless called from the task itself. Ids that were
+         * never scheduled (including 0) or already retired return at once.
+         */
+        void cancel(TimerId id)
+        {
+            if (id == 0)
+            {
+                return;
+            }
+            std::unique_lock<std::mutex> lk(_mutex);
+            _timers.erase(id);
+            // Only a task running right now can still be waited on.
+            if (_running == id && std::this_thread::get_id() != _thread.get_id())
+            {
+                _cv.wait(lk, [this, id]()
+                         { return _running != id; });
+            }
+        }
+
+    private:
+        struct Timer
+        {
+            Task task;
+            std::size_t rounds;
+        };
+
+        // Caller holds _mutex.
+        void place(TimerId id, std::chrono::milliseconds delay)
+        {
+            const std::size_t ticks = std::max<std::size_t>(1, static_cast<std::size_t>((delay + kTick - std::chrono::milliseconds(1)) / kTick));
+            _timers[id].rounds = (ticks - 1) / kSlots;
+            _slots[(_cursor + ticks) % kSlots].push_back(id);
+            ++_pending;
+        }
+
+        void run()
+        {
+            std::unique_lock<std::mutex> lk(_mutex);
+            auto nextTick = std::chrono::steady_clock::now() + kTick;
+            std::vector<TimerId> due;
+            while (!_stopping)
+            {
+                if (_pending == 0)
+                {
+                    _cv.wait(lk, [this]()
+                             { return _stopping || _pending > 0; });
+                    nextTick = std::chrono::steady_clock::now() + kTick;
+                    continue;
+                }
+                if (_cv.wait_until(lk, nextTick, [this]()
+                                   { return _stopping; }))
+                {
+                    break;
+                }
+                nextTick += kTick;
+
+                _cursor = (_cursor + 1) % kSlots;
+                auto &slot = _slots[_cursor];
+                std::size_t kept = 0;
+                for (const TimerId id : slot)
+                {
+                    const auto it = _timers.find(id);
+                    if (it != _timers.end() && it->second.rounds > 0)
+                    {
+                        --it->second.rounds;
+                        slot[kept++] = id;
+                        continue;
+                    }
+                    --_pending;
+                    if (it != _timers.end())
+                    {
+                        due.push_back(id);
+                    }
+                }
+                slot.resize(kept);
+
+                for (const TimerId id : due)
+                {
+                    auto it = _timers.find(id);
+                    if (it == _timers.end())
+                    {
+                        continue;
+                    }
+                    Task task = it->second.task;
+                    _running = id;
+                    lk.unlock();
+                    std::chrono::milliseconds again{0};
+                    try
+                    {
+                        again = task();
+                    }
+                    catch (const std::exception &e)
+                    {
+                        spdlog::error("timer task threw: {}", e.what());
+                    }
+                    lk.lock();
+                    _running = 0;
+                    if (_timers.count(id) > 0)
+                    {
+                        if (again.count() > 0)
+                        {
+                            place(id, again);
+                        }
+                        else
+                        {
+                            _timers.erase(id);
+                        }
+                    }
+                    _cv.notify_all();
+                }
+                due.clear();
+            }
+        }
+
+        std::mutex _mutex;
+        std::condition_variable _cv;
+        std::thread _thread;
+        bool _stopping = false;
+
+        std::vector<std::vector<TimerId>> _slots;
+        std::size_t _cursor = 0;
+        // Slot entries not yet visited, including those of cancelled timers.
+        std::size_t _pending = 0;
+        std::unordered_map<TimerId, Timer> _timers;
+        TimerId _nextId = 1;
+        TimerId _running = 0;
+    };
+}
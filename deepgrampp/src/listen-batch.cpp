@@ -0,0 +1,314 @@
+#include "listen-batch.hpp"
+#include "transport/curl_http_transport.hpp"
+#include <spdlog/spdlog.h>
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <fstream>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <unordered_set>
+
+using namespace deepgram::listen;
+
+namespace
+{
+    /**
+     * Paths recorded as successful in an existing JSONL output file. Lines
+     * that don't parse (e.g. one truncated by a crash mid-write) are ignored,
+     * which simply means that file gets transcribed again.
+     */
+    std::unordered_set<std::string> readCompletedPaths(const std::string &outputPath)
+    {
+        std::unordered_set<std::string> completed;
+        std::ifstream in(outputPath);
+        std::string line;
+        while (std::getline(in, line))
+        {
+            try
+            {
+                const auto j = nlohmann::json::parse(line);
+                if (j.value("success", false) && j.contains("path"))
+                {
+                    completed.insert(j["path"].get<std::string>());
+                }
+            }
+            catch (const std::exception &)
+            {
+            }
+        }
+        return completed;
+    }
+
+    /**
+     * True if `path` exists, is non-empty and its last byte isn't a newline --
+     * i.e. a previous run crashed mid-line and the next line must not be glued
+     * onto the truncated one.
+     */
+    bool endsWithPartialLine(const std::string &path)
+    {
+        std::ifstream in(path, std::ios::binary | std::ios::ate);
+        if (!in || in.tellg() <= 0)
+        {
+            return false;
+        }
+        in.seekg(-1, std::ios::end);
+        char last = '\n';
+        in.get(last);
+        return last != '\n';
+    }
+
+    std::string trimmed(const std::string &value)
+    {
+        const auto begin = value.find_first_not_of(" \t\r\n");
+        if (begin == std::string::npos)
+        {
+            return {};
+        }
+        const auto end = value.find_last_not_of(" \t\r\n");
+        return value.substr(begin, end - begin + 1);
+    }
+}
+
+BatchTranscriber::BatchTranscriber(const std::string &apiKey, BatchOptions options)
+    : _apiKey(apiKey), _options(std::move(options))
+{
+    if (!_options.transportFactory)
+    {
+        const std::string caFilePath = _options.caFilePath;
+        _options.transportFactory = [caFilePath]()
+        {
+            return std::make_shared<transport::CurlHttpTransport>(caFilePath, transport::CurlShareContext::processWide());
+        };
+    }
+}
+
+BatchTranscriber::~BatchTranscriber() = default;
+
+void BatchTranscriber::setProgressCallback(ProgressCallback callback)
+{
+    _progressCallback = std::move(callback);
+}
+
+void BatchTranscriber::cancel()
+{
+    _cancelled.store(true);
+}
+
+BatchSummary BatchTranscriber::run(const std::vector<std::string> &paths)
+{
+    std::vector<BatchItem> items;
+    items.reserve(paths.size());
+    for (const auto &path : paths)
+    {
+        items.push_back(BatchItem{path, {}});
+    }
+    return run(items);
+}
+
+BatchSummary BatchTranscriber::runManifest(const std::string &manifestPath)
+{
+    std::ifstream in(manifestPath);
+    if (!in)
+    {
+        throw std::runtime_error("Failed to open manifest: " + manifestPath);
+    }
+
+    std::vector<BatchItem> items;
+    std::string line;
+    std::size_t lineNumber = 0;
+    while (std::getline(in, line))
+    {
+        ++lineNumber;
+        line = trimmed(line);
+        if (line.empty() || line[0] == '#')
+        {
+            continue;
+        }
+        if (line[0] == '{')
+        {
+            try
+            {
+                const auto j = nlohmann::json::parse(line);
+                items.push_back(BatchItem{j.at("path").get<std::string>(), j.value("content_type", "")});
+            }
+            catch (const nlohmann::json::exception &e)
+            {
+                throw std::runtime_error("Invalid manifest entry at " + manifestPath + ":" + std::to_string(lineNumber) + ": " + e.what());
+            }
+        }
+        else
+        {
+            items.push_back(BatchItem{line, {}});
+        }
+    }
+    return run(items);
+}
+
+BatchSummary BatchTranscriber::run(const std::vector<BatchItem> &items)
+{
+    _cancelled.store(false);
+
+    BatchSummary summary;
+    summary.total = items.size();
+
+    if (_options.outputPath.empty())
+    {
+        spdlog::error("can't run batch, BatchOptions::outputPath is not set");
+        return summary;
+    }
+
+    std::vector<const BatchItem *> pending;
+    {
+        const auto completed = _options.resume ? readCompletedPaths(_options.outputPath)
+                                               : std::unordered_set<std::string>{};
+        for (const auto &item : items)
+        {
+            if (completed.count(item.path) != 0)
+            {
+                ++summary.skipped;
+            }
+            else
+            {
+                pending.push_back(&item);
+            }
+        }
+    }
+    if (summary.skipped > 0)
+    {
+        spdlog::info("Skipping {} already transcribed file(s) found in {}", summary.skipped, _options.outputPath);
+    }
+
+    const bool needsNewline = endsWithPartialLine(_options.outputPath);
+    std::ofstream out(_options.outputPath, std::ios::app);
+    if (!out)
+    {
+        spdlog::error("can't run batch, failed to open output file: {}", _options.outputPath);
+        return summary;
+    }
+    if (needsNewline)
+    {
+        out << '\n';
+    }
+
+    std::mutex resultMutex;
+    std::atomic<std::size_t> nextIndex{0};
+    std::string transportError; // guarded by resultMutex
+
+    auto record = [&](const BatchItem &item, bool success, long statusCode, const nlohmann::json &line)
+    {
+        // Invalid UTF-8 (a non-UTF-8 path, a binary error body) is replaced
+        // rather than thrown on.
+        const std::string serialized = line.dump(-1, ' ', false, nlohmann::json::error_handler_t::replace);
+
+        std::lock_guard<std::mutex> lk(resultMutex);
+        // One flushed line per file: a crash can at worst truncate the line
+        // being written, which the checkpoint reader then ignores.
+        out << serialized << '\n';
+        out.flush();
+
+        ++summary.completed;
+        success ? ++summary.succeeded : ++summary.failed;
+        summary.path = item.path;
+        summary.success = success;
+        summary.statusCode = statusCode;
+        if (_progressCallback)
+        {
+            try
+            {
+                _progressCallback(summary);
+            }
+            catch (const std::exception &e)
+            {
+                spdlog::error("Batch progress callback threw: {}", e.what());
+            }
+            catch (...)
+            {
+                spdlog::error("Batch progress callback threw an unknown exception");
+            }
+        }
+    };
+
+    auto recordFailure = [&](const BatchItem &item, const std::string &error)
+    {
+        record(item, false, 0, {{"path", item.path}, {"success", false}, {"status_code", 0}, {"error", error}});
+    };
+
+    auto worker = [&]()
+    {
+        std::unique_ptr<ListenRestClient> client;
+        try
+        {
+            client = std::make_unique<ListenRestClient>(_apiKey, _options.transportFactory());
+        }
+        catch (const std::exception &e)
+        {
+            spdlog::error("Batch worker failed to create its transport: {}", e.what());
+            std::lock_guard<std::mutex> lk(resultMutex);
+            transportError = e.what();
+            return;
+        }
+        client->setRetryPolicy(_options.retryPolicy);
+        client->setRateLimiter(_options.rateLimiter);
+
+        for (;;)
+        {
+            if (_cancelled.load())
+            {
+                return;
+            }
+            const std::size_t index = nextIndex.fetch_add(1);
+            if (index >= pending.size())
+            {
+                return;
+            }
+            const BatchItem &item = *pending[index];
+            const std::string &contentType = item.contentType.empty() ? _options.contentType : item.contentType;
+
+            // Nothing may escape the thread: a failure becomes a failed line.
+            try
+            {
+                const auto result = client->transcribeFile(item.path, contentType, _options.options);
+
+                nlohmann::json line = {{"path", item.path}, {"success", result.success}, {"status_code", result.statusCode}};
+                if (result.success)
+                {
+                    line["response"] = result.response.toJson();
+                }
+                else
+                {
+                    line["error"] = result.errorMessage;
+                }
+                record(item, result.success, result.statusCode, line);
+            }
+            catch (const std::exception &e)
+            {
+                spdlog::error("Batch item {} failed: {}", item.path, e.what());
+                recordFailure(item, e.what());
+            }
+        }
+    };
+
+    const int workerCount = std::max(1, std::min<int>(_options.concurrency, static_cast<int>(pending.size())));
+    std::vector<std::thread> workers;
+    workers.reserve(workerCount);
+    for (int i = 0; i < workerCount && !pending.empty(); ++i)
+    {
+        workers.emplace_back(worker);
+    }
+    for (auto &thread : workers)
+    {
+        thread.join();
+    }
+
+    // Left unclaimed only when no worker could create a transport.
+    for (std::size_t index = nextIndex.load(); index < pending.size() && !_cancelled.load(); ++index)
+    {
+        recordFailure(*pending[index], "no batch worker could create a transport: " + transportError);
+    }
+
+    spdlog::info("Batch finished: {} succeeded, {} failed, {} skipped, {} total",
+                 summary.succeeded, summary.failed, summary.skipped, summary.total);
+    return summary;
+}
@@ -0,0 +1,170 @@
+#include "listen-cache.hpp"
+#include "impl/content-hash.hpp"
+#include "impl/lru-cache.hpp"
+#include <spdlog/spdlog.h>
+#include <nlohmann/json.hpp>
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <mutex>
+#include <system_error>
+#include <thread>
+
+namespace fs = std::filesystem;
+
+namespace deepgram
+{
+    namespace listen
+    {
+        namespace
+        {
+            constexpr const char *kFileSuffix = ".dgcache.json";
+        }
+
+        struct TranscriptionCacheState
+        {
+            TranscriptionCacheOptions options;
+            mutable std::mutex mutex;
+            LruCache<PrerecordedTranscriptionResponse> memory;
+
+            fs::path pathFor(const std::string &key) const
+            {
+                // Two differently seeded hashes so file names don't collide in
+                // practice; the full key is stored inside and checked on read.
+                return fs::path(options.directory) /
+                       (ContentHasher::toHex(ContentHasher::hash(key.data(), key.size(), 0)) +
+                        ContentHasher::toHex(ContentHasher::hash(key.data(), key.size(), 1)) + kFileSuffix);
+            }
+
+            std::optional<PrerecordedTranscriptionResponse> readDisk(const std::string &key) const
+            {
+                std::ifstream in(pathFor(key), std::ios::binary);
+                if (!in)
+                {
+                    return std::nullopt;
+                }
+                try
+                {
+                    const auto j = nlohmann::json::parse(in);
+                    if (j.value("key", "") != key)
+                    {
+                        return std::nullopt;
+                    }
+                    return PrerecordedTranscriptionResponse::fromJson(j.at("response"));
+                }
+                catch (const std::exception &e)
+                {
+                    spdlog::warn("Ignoring unreadable transcription cache entry {}: {}", pathFor(key).string(), e.what());
+                    return std::nullopt;
+                }
+            }
+
+            void writeDisk(const std::string &key, const PrerecordedTranscriptionResponse &response) const
+            {
+                std::error_code ec;
+                fs::create_directories(options.directory, ec);
+                const fs::path path = pathFor(key);
+                // Write next to the final name and rename, so concurrent
+                // readers (or a crash) never see a half-written entry.
+                fs::path tmp = path;
+                tmp += ".tmp" + std::to_string(std::hash<std::thread::id>{}(std::this_thread::get_id()));
+                {
+                    std::ofstream out(tmp, std::ios::binary | std::ios::trunc);
+                    if (!out)
+                    {
+                        spdlog::warn("can't write transcription cache entry {}", tmp.string());
+                        return;
+                    }
+                    out << nlohmann::json{{"key", key}, {"response", response.toJson()}}.dump();
+                    if (!out)
+                    {
+                        out.close();
+                        fs::remove(tmp, ec);
+                        return;
+                    }
+                }
+                fs::rename(tmp, path, ec);
+                if (ec)
+                {
+                    spdlog::warn("can't store transcription cache entry {}: {}", path.string(), ec.message());
+                    fs::remove(tmp, ec);
+                }
+            }
+        };
+
+        TranscriptionCache::TranscriptionCache(TranscriptionCacheOptions options)
+            : _state(std::make_unique<TranscriptionCacheState>())
+        {
+            _state->options = std::move(options);
+            _state->memory.setCapacity(_state->options.maxMemoryEntries);
+        }
+
+        TranscriptionCache::~TranscriptionCache() = default;
+
+        std::optional<PrerecordedTranscriptionResponse> TranscriptionCache::get(const std::string &key)
+        {
+            {
+                std::lock_guard<std::mutex> lk(_state->mutex);
+                if (const auto *cached = _state->memory.find(key))
+                {
+                    return *cached;
+                }
+            }
+            if (_state->options.directory.empty())
+            {
+                return std::nullopt;
+            }
+
+            auto response = _state->readDisk(key);
+            if (response)
+            {
+                std::lock_guard<std::mutex> lk(_state->mutex);
+                _state->memory.put(key, *response);
+            }
+            return response;
+        }
+
+        void TranscriptionCache::put(const std::string &key, const PrerecordedTranscriptionResponse &response)
+        {
+            {
+                std::lock_guard<std::mutex> lk(_state->mutex);
+                _state->memory.put(key, response);
+            }
+            if (!_state->options.directory.empty())
+            {
+                _state->writeDisk(key, response);
+            }
+        }
+
+        void TranscriptionCache::clear()
+        {
+            {
+                std::lock_guard<std::mutex> lk(_state->mutex);
+                _state->memory.clear();
+            }
+            if (_state->options.directory.empty())
+            {
+                return;
+            }
+            std::error_code ec;
+            for (fs::directory_iterator it(_state->options.directory, ec), end; !ec && it != end; it.increment(ec))
+            {
+                const std::string name = it->path().filename().string();
+                if (name.size() > std::strlen(kFileSuffix) &&
+                    name.compare(name.size() - std::strlen(kFileSuffix), std::string::npos, kFileSuffix) == 0)
+                {
+                    std::error_code removeError;
+                    fs::remove(it->path(), removeError);
+                }
+            }
+        }
+
+        std::size_t TranscriptionCache::memoryEntries() const
+        {
+            std::lock_guard<std::mutex> lk(_state->mutex);
+            return _state->memory.size();
+        }
+    }
+}
@@ -8,32 +8,26 @@ deepgram::listen::flux::ListenFluxClient::ListenFluxClient(const std::string& ap
     std::make_unique<ListenFluxClientImpl>("api.deepgram.com", apiKey, std::move(wsTransport), caFilePath)
 )
 {
+    // Each event type is decoded once, by its own decoder, and only when a
+    // callback for it is registered.
+    MessageRouter& router = _fluxClientImpl->router();
+    router.add(event::type::TURN_INFO,
+        [this]() { return static_cast<bool>(_onTurnInfoCallback); },
+        [this](const std::string& message) { _onTurnInfoCallback(event::TurnInfo::fromJson(nlohmann::json::parse(message))); });
+    router.add(event::type::CONNECTED,
+        [this]() { return static_cast<bool>(_onConnectedCallback); },
+        [this](const std::string& message) { _onConnectedCallback(event::Connected::fromJson(nlohmann::json::parse(message))); });
+    router.add(event::type::FATAL_ERROR,
+        [this]() { return static_cast<bool>(_onFatalErrorCallback); },
+        [this](const std::string& message) { _onFatalErrorCallback(event::FatalError::fromJson(nlohmann::json::parse(message))); });
+    router.setFallback([](const std::string&, std::optional<std::string_view> type) {
+        spdlog::warn("Received unknown message type: {}", type ? std::string(*type) : std::string());
+        });
+
     // Wired up now, before connect() is ever called, so no messages are missed.
     std::function<void(const std::string&)> onDataReception = [this](const std::string& message) {
         try {
-            auto jsonPayload = nlohmann::json::parse(message);
-            std::string type = jsonPayload.value("type", "");
-            if (type == event::type::TURN_INFO) {
-                if (this->_onTurnInfoCallback) {
-                    auto turnInfo = event::TurnInfo::fromJson(jsonPayload);
-                    this->_onTurnInfoCallback(turnInfo);
-                }
-            }
-            else if (type == event::type::CONNECTED) {
-                if (this->_onConnectedCallback) {
-                    auto connected = event::Connected::fromJson(jsonPayload);
-                    this->_onConnectedCallback(connected);
-                }
-            }
-            else if (type == event::type::FATAL_ERROR) {
-                if (this->_onFatalErrorCallback) {
-                    auto fatalError = event::FatalError::fromJson(jsonPayload);
-                    this->_onFatalErrorCallback(fatalError);
-                }
-            }
-            else {
-                spdlog::warn("Received unknown message type: {}", type);
-            }
+            _fluxClientImpl->router().route(message);
         }
         catch (const std::exception& e) {
             spdlog::error("Error parsing message: {}, error: {}", message, e.what());
@@ -80,6 +74,60 @@ bool deepgram::listen::flux::ListenFluxClient::streamAudio(const std::vector<uin
     return _fluxClientImpl->streamAudio(audioData, chunkSize);
 }
 
+bool deepgram::listen::flux::ListenFluxClient::streamAudioPaced(const std::vector<uint8_t>& audioData, const audio::PacingOptions& pacing)
+{
+    if (!_fluxClientImpl) {
+        spdlog::error("cannot stream audio, ListenFluxClientImpl is not initialized.");
+        return false;
+    }
+    return _fluxClientImpl->streamAudioPaced(audioData, pacing);
+}
+
+bool deepgram::listen::flux::ListenFluxClient::pushAudio(const uint8_t* data, size_t size)
+{
+    if (!_fluxClientImpl) {
+        spdlog::error("cannot push audio, ListenFluxClientImpl is not initialized.");
+        return false;
+    }
+    return _fluxClientImpl->pushAudio(data, size);
+}
+
+void deepgram::listen::flux::ListenFluxClient::setAudioPushOptions(const audio::PushOptions& options)
+{
+    if (!_fluxClientImpl) {
+        spdlog::error("cannot set audio push options, ListenFluxClientImpl is not initialized.");
+        return;
+    }
+    _fluxClientImpl->setPushOptions(options);
+}
+
+std::size_t deepgram::listen::flux::ListenFluxClient::droppedAudioBytes() const
+{
+    if (!_fluxClientImpl) {
+        spdlog::error("cannot get dropped audio bytes, ListenFluxClientImpl is not initialized.");
+        return 0;
+    }
+    return _fluxClientImpl->droppedAudioBytes();
+}
+
+void deepgram::listen::flux::ListenFluxClient::setAudioInputFormat(const audio::AudioFormat& format)
+{
+    if (!_fluxClientImpl) {
+        spdlog::error("cannot set audio input format, ListenFluxClientImpl is not initialized.");
+        return;
+    }
+    _fluxClientImpl->setAudioInputFormat(format);
+}
+
+void deepgram::listen::flux::ListenFluxClient::addAudioStage(std::shared_ptr<audio::IAudioStage> stage)
+{
+    if (!_fluxClientImpl) {
+        spdlog::error("cannot add audio stage, ListenFluxClientImpl is not initialized.");
+        return;
+    }
+    _fluxClientImpl->addAudioStage(std::move(stage));
+}
+
 void deepgram::listen::flux::ListenFluxClient::sendCloseStream()
 {
     if (!_fluxClientImpl) {
@@ -89,6 +137,15 @@ void deepgram::listen::flux::ListenFluxClient::sendCloseStream()
     _fluxClientImpl->sendCloseStream();
 }
 
+void deepgram::listen::flux::ListenFluxClient::setCloseTimeout(std::chrono::milliseconds timeout)
+{
+    if (!_fluxClientImpl) {
+        spdlog::error("cannot set close timeout, ListenFluxClientImpl is not initialized.");
+        return;
+    }
+    _fluxClientImpl->setCloseTimeout(timeout);
+}
+
 void deepgram::listen::flux::ListenFluxClient::setOnTurnInfoCallback(OnTurnInfoCallback callback)
 {
     _onTurnInfoCallback = callback;
@@ -103,3 +160,12 @@ void deepgram::listen::flux::ListenFluxClient::setOnFatalErrorCallback(OnFatalEr
 {
     _onFatalErrorCallback = callback;
 }
+
+void deepgram::listen::flux::ListenFluxClient::setRateLimiter(std::shared_ptr<RateLimiter> rateLimiter)
+{
+    if (!_fluxClientImpl) {
+        spdlog::error("cannot set rate limiter, ListenFluxClientImpl is not initialized.");
+        return;
+    }
+    _fluxClientImpl->setRateLimiter(std::move(rateLimiter));
+}
@@ -47,3 +47,55 @@ PrerecordedTranscriptionResult ListenRestClient::transcribeFile(const std::strin
     }
     return impl_->transcribeFile(filePath, contentType, options);
 }
+
+PrerecordedTranscriptionResult ListenRestClient::transcribeSegmented(const std::vector<uint8_t> &audioData,
+                                                                       const LiveTranscriptionOptions &options,
+                                                                       const SegmentationOptions &segmentation)
+{
+    if (!impl_)
+    {
+        spdlog::error("can't transcribe, ListenRestClientImpl is not initialized");
+        return PrerecordedTranscriptionResult{};
+    }
+    return impl_->transcribeSegmented(audioData, options, segmentation);
+}
+
+void ListenRestClient::setRetryPolicy(const RetryPolicy &policy)
+{
+    if (!impl_)
+    {
+        spdlog::error("can't set retry policy, ListenRestClientImpl is not initialized");
+        return;
+    }
+    impl_->setRetryPolicy(policy);
+}
+
+void ListenRestClient::setRateLimiter(std::shared_ptr<RateLimiter> rateLimiter)
+{
+    if (!impl_)
+    {
+        spdlog::error("can't set rate limiter, ListenRestClientImpl is not initialized");
+        return;
+    }
+    impl_->setRateLimiter(std::move(rateLimiter));
+}
+
+void ListenRestClient::setResultCache(std::shared_ptr<TranscriptionCache> cache)
+{
+    if (!impl_)
+    {
+        spdlog::error("can't set result cache, ListenRestClientImpl is not initialized");
+        return;
+    }
+    impl_->setResultCache(std::move(cache));
+}
+
+void ListenRestClient::setDecodeProfile(DecodeProfile profile)
+{
+    if (!impl_)
+    {
+        spdlog::error("can't set decode profile, ListenRestClientImpl is not initialized");
+        return;
+    }
+    impl_->setDecodeProfile(profile);
+}
@@ -1,10 +1,47 @@
 
 #include "listen-ws.hpp"
 #include "impl/listen-ws-impl-lws.hpp"
+#include "impl/listen-decode.hpp"
+#include "impl/listen-sax.hpp"
 #include <spdlog/spdlog.h>
 
 using namespace deepgram::listen;
 
+namespace
+{
+    // Server times count only the audio the voice activity gate let through;
+    // maps them, and the durations spanning them, back to stream time.
+    template <typename Result>
+    void remapTimes(Result &result, const deepgram::audio::VoiceActivityGate &gate)
+    {
+        if (result.start)
+        {
+            const double start = gate.toStreamTime(*result.start);
+            if (result.duration)
+            {
+                result.duration = gate.toStreamTime(*result.start + *result.duration) - start;
+            }
+            result.start = start;
+        }
+        for (auto &alternative : result.channel.alternatives)
+        {
+            for (auto &word : alternative.words)
+            {
+                word.start = gate.toStreamTime(word.start);
+                word.end = gate.toStreamTime(word.end);
+            }
+        }
+    }
+
+    void remapTime(std::optional<double> &time, const deepgram::audio::VoiceActivityGate *gate)
+    {
+        if (gate && time)
+        {
+            time = gate->toStreamTime(*time);
+        }
+    }
+}
+
 ListenWebsocketClient::ListenWebsocketClient(const std::string &apiKey,
                                               std::shared_ptr<transport::IWebSocketTransport> wsTransport,
                                               const std::string &caFilePath)
@@ -15,7 +52,127 @@ ListenWebsocketClient::ListenWebsocketClient(const std::string &apiKey,
         [this](const std::string &message)
         { handleResponse(message); },
         [this](const std::string &error)
-        { onError_(error); });
+        {
+            if (onError_)
+            {
+                onError_(error);
+            }
+        });
+
+    // Each message type is decoded once, by its own decoder, and only when a
+    // callback for it is registered.
+    MessageRouter &router = websocketClientImpl_->router();
+    router.add(
+        result::RESULTS,
+        [this]()
+        { return onPartialTranscription_ || onFinalTranscription_ || onTranscriptView_ || onArenaTranscription_; },
+        [this](const std::string &message)
+        {
+            if (onArenaTranscription_)
+            {
+                ResultArena::Lease lease(websocketClientImpl_->resultArena());
+                pmr::ListenMessage decoded(websocketClientImpl_->resultArena().resource());
+                decodeListenMessageSax(message, decoded, decodeProfile_);
+                if (const audio::VoiceActivityGate *gate = websocketClientImpl_->voiceGate())
+                {
+                    remapTimes(decoded.result, *gate);
+                }
+                onArenaTranscription_(decoded.result);
+            }
+            if (!onPartialTranscription_ && !onFinalTranscription_ && !onTranscriptView_)
+            {
+                return;
+            }
+            TranscriptionResult transcriptionResult = jsonBackend_ == JsonBackend::Sax
+                                                          ? decodeListenMessageSax(message, decodeProfile_).result
+                                                          : TranscriptionResult::fromJson(parseWithProfile(message, decodeProfile_));
+            if (const audio::VoiceActivityGate *gate = websocketClientImpl_->voiceGate())
+            {
+                remapTimes(transcriptionResult, *gate);
+            }
+            if (transcriptionResult.isFinal || transcriptionResult.speech_final)
+            {
+                if (onFinalTranscription_)
+                {
+                    onFinalTranscription_(transcriptionResult);
+                }
+            }
+            else if (onPartialTranscription_)
+            {
+                onPartialTranscription_(transcriptionResult);
+            }
+            if (onTranscriptView_)
+            {
+                onTranscriptView_(transcriptionResult.view());
+            }
+        });
+    router.add(
+        result::METADATA,
+        [this]()
+        { return onMetadata_ || onRawMetadata_; },
+        [this](const std::string &message)
+        {
+            if (onRawMetadata_)
+            {
+                const nlohmann::json json = nlohmann::json::parse(message);
+                onRawMetadata_(json);
+                if (onMetadata_)
+                {
+                    onMetadata_(Metadata::fromJson(json));
+                }
+                return;
+            }
+            onMetadata_(decodeMetadataSax(message));
+        });
+    router.add(
+        result::UTTERANCE_END,
+        [this]()
+        { return static_cast<bool>(onUtteranceEnd_); },
+        [this](const std::string &message)
+        {
+            if (jsonBackend_ == JsonBackend::Sax)
+            {
+                ListenMessage decoded = decodeListenMessageSax(message);
+                UtteranceEnd utteranceEnd;
+                utteranceEnd.type = std::move(decoded.result.type);
+                utteranceEnd.last_word_end = decoded.lastWordEnd;
+                remapTime(utteranceEnd.last_word_end, websocketClientImpl_->voiceGate());
+                onUtteranceEnd_(utteranceEnd);
+            }
+            else
+            {
+                UtteranceEnd utteranceEnd = UtteranceEnd::fromJson(nlohmann::json::parse(message));
+                remapTime(utteranceEnd.last_word_end, websocketClientImpl_->voiceGate());
+                onUtteranceEnd_(utteranceEnd);
+            }
+        });
+    router.add(
+        result::SPEECH_STARTED,
+        [this]()
+        { return static_cast<bool>(onSpeechStarted_); },
+        [this](const std::string &message)
+        {
+            if (jsonBackend_ == JsonBackend::Sax)
+            {
+                ListenMessage decoded = decodeListenMessageSax(message);
+                SpeechStarted speechStarted;
+                speechStarted.type = std::move(decoded.result.type);
+                speechStarted.timestamp = decoded.timestamp;
+                remapTime(speechStarted.timestamp, websocketClientImpl_->voiceGate());
+                onSpeechStarted_(speechStarted);
+            }
+            else
+            {
+                SpeechStarted speechStarted = SpeechStarted::fromJson(nlohmann::json::parse(message));
+                remapTime(speechStarted.timestamp, websocketClientImpl_->voiceGate());
+                onSpeechStarted_(speechStarted);
+            }
+        });
+    router.setFallback(
+        [](const std::string &, std::optional<std::string_view> type)
+        {
+            std::cout << "Received unknown message type: " << (type ? std::string(*type) : std::string()) << std::endl;
+        });
 }
 
 ListenWebsocketClient::~ListenWebsocketClient()
@@ -56,6 +213,80 @@ bool ListenWebsocketClient::streamAudio(const std::vector<uint8_t> &audioData, i
     return websocketClientImpl_->streamAudio(audioData, chunkSize);
 }
 
+bool ListenWebsocketClient::streamAudioPaced(const std::vector<uint8_t> &audioData, const audio::PacingOptions &pacing)
+{
+    if (!websocketClientImpl_) {
+        spdlog::error("can't stream audio file, websocketClientImpl_ is not initialized");
+        return false;
+    }
+    return websocketClientImpl_->streamAudioPaced(audioData, pacing);
+}
+
+bool ListenWebsocketClient::pushAudio(const uint8_t *data, size_t size)
+{
+    if (!websocketClientImpl_) {
+        spdlog::error("can't push audio, websocketClientImpl_ is not initialized");
+        return false;
+    }
+    return websocketClientImpl_->pushAudio(data, size);
+}
+
+void ListenWebsocketClient::setAudioPushOptions(const audio::PushOptions &options)
+{
+    if (!websocketClientImpl_) {
+        spdlog::error("can't set audio push options, websocketClientImpl_ is not initialized");
+        return;
+    }
+    websocketClientImpl_->setPushOptions(options);
+}
+
+std::size_t ListenWebsocketClient::droppedAudioBytes() const
+{
+    if (!websocketClientImpl_) {
+        spdlog::error("can't get dropped audio bytes, websocketClientImpl_ is not initialized");
+        return 0;
+    }
+    return websocketClientImpl_->droppedAudioBytes();
+}
+
+void ListenWebsocketClient::setAudioInputFormat(const audio::AudioFormat &format)
+{
+    if (!websocketClientImpl_) {
+        spdlog::error("can't set audio input format, websocketClientImpl_ is not initialized");
+        return;
+    }
+    websocketClientImpl_->setAudioInputFormat(format);
+}
+
+void ListenWebsocketClient::addAudioStage(std::shared_ptr<audio::IAudioStage> stage)
+{
+    if (!websocketClientImpl_) {
+        spdlog::error("can't add audio stage, websocketClientImpl_ is not initialized");
+        return;
+    }
+    websocketClientImpl_->addAudioStage(std::move(stage));
+}
+
+void ListenWebsocketClient::setVoiceActivityGate(std::shared_ptr<audio::VoiceActivityGate> gate)
+{
+    if (!websocketClientImpl_) {
+        spdlog::error("can't set voice activity gate, websocketClientImpl_ is not initialized");
+        return;
+    }
+    websocketClientImpl_->setVoiceActivityGate(std::move(gate));
+}
+
+#if defined(DEEPGRAMPP_WITH_OPUS)
+void ListenWebsocketClient::setOpusEncoder(std::shared_ptr<audio::OpusEncoderStage> encoder)
+{
+    if (!websocketClientImpl_) {
+        spdlog::error("can't set Opus encoder, websocketClientImpl_ is not initialized");
+        return;
+    }
+    websocketClientImpl_->setOpusEncoder(std::move(encoder));
+}
+#endif
+
 bool deepgram::listen::ListenWebsocketClient::sendFinalizeMessage()
 {
     if (!websocketClientImpl_) {
@@ -87,39 +318,7 @@ void ListenWebsocketClient::handleResponse(const std::string &message)
 {
     try
     {
-        nlohmann::json json = nlohmann::json::parse(message);
-
-        deepgram::listen::TranscriptionResult transcriptionResult = deepgram::listen::TranscriptionResult::fromJson(json);
-
-        if (transcriptionResult.type == result::RESULTS)
-        {
-            if (transcriptionResult.isFinal || transcriptionResult.speech_final)
-            {
-                onFinalTranscription_(transcriptionResult);
-            }
-            else
-            {
-                onPartialTranscription_(transcriptionResult);
-            }
-        }
-        else if (transcriptionResult.type == result::METADATA)
-        {
-            onMetadata_(json);
-        }
-        else if (transcriptionResult.type == result::UTTERANCE_END)
-        {
-            deepgram::listen::UtteranceEnd utteranceEnd = deepgram::listen::UtteranceEnd::fromJson(json);
-            onUtteranceEnd_(utteranceEnd);
-        }
-        else if (transcriptionResult.type == result::SPEECH_STARTED)
-        {
-            deepgram::listen::SpeechStarted speechStarted = deepgram::listen::SpeechStarted::fromJson(json);
-            onSpeechStarted_(speechStarted);
-        }
-        else
-        {
-            std::cout << "Received unknown message type: " << transcriptionResult.type << std::endl;
-        }
+        websocketClientImpl_->router().route(message);
     }
     catch (const std::exception &e)
     {
@@ -143,6 +342,15 @@ void ListenWebsocketClient::close()
     websocketClientImpl_->close();
 }
 
+void ListenWebsocketClient::setCloseTimeout(std::chrono::milliseconds timeout)
+{
+    if (!websocketClientImpl_) {
+        spdlog::error("can't set close timeout, websocketClientImpl_ is not initialized");
+        return;
+    }
+    websocketClientImpl_->setCloseTimeout(timeout);
+}
+
 void ListenWebsocketClient::setOnPartialTranscription(PartialTranscriptionCallback cb)
 {
     onPartialTranscription_ = std::move(cb);
@@ -158,6 +366,11 @@ void ListenWebsocketClient::setOnMetadata(MetadataCallback cb)
     onMetadata_ = std::move(cb);
 }
 
+void ListenWebsocketClient::setOnRawMetadata(RawMetadataCallback cb)
+{
+    onRawMetadata_ = std::move(cb);
+}
+
 void ListenWebsocketClient::setOnError(ErrorCallback cb)
 {
     onError_ = std::move(cb);
@@ -172,3 +385,32 @@ void deepgram::listen::ListenWebsocketClient::setUtteranceEndCallback(UtteranceE
 {
     onUtteranceEnd_ = std::move(cb);
 }
+
+void ListenWebsocketClient::setOnTranscriptView(TranscriptViewCallback cb)
+{
+    onTranscriptView_ = std::move(cb);
+}
+
+void ListenWebsocketClient::setOnArenaTranscription(ArenaTranscriptionCallback cb)
+{
+    onArenaTranscription_ = std::move(cb);
+}
+
+void ListenWebsocketClient::setRateLimiter(std::shared_ptr<RateLimiter> rateLimiter)
+{
+    if (!websocketClientImpl_) {
+        spdlog::error("can't set rate limiter, websocketClientImpl_ is not initialized");
+        return;
+    }
+    websocketClientImpl_->setRateLimiter(std::move(rateLimiter));
+}
+
+void ListenWebsocketClient::setJsonBackend(JsonBackend backend)
+{
+    jsonBackend_ = backend;
+}
+
+void ListenWebsocketClient::setDecodeProfile(DecodeProfile profile)
+{
+    decodeProfile_ = profile;
+}
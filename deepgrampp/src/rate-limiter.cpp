@@ -0,0 +1,153 @@
+#include "rate-limiter.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+
+namespace deepgram
+{
+    struct RateLimiterState
+    {
+        using Clock = std::chrono::steady_clock;
+
+        /**
+         * FIFO admission for one kind of work: a caller takes a ticket and is
+         * only admitted once every earlier ticket of the same kind has been.
+         */
+        struct Lane
+        {
+            int limit = 0;
+            int active = 0;
+            std::uint64_t nextTicket = 0;
+            std::uint64_t servingTicket = 0;
+        };
+
+        RateLimiterOptions options;
+        mutable std::mutex mutex;
+        std::condition_variable cv;
+        Lane streams;
+        Lane requests;
+        double tokens = 0.0;
+        Clock::time_point lastRefill = Clock::now();
+
+        void refill(Clock::time_point now)
+        {
+            const std::chrono::duration<double> elapsed = now - lastRefill;
+            tokens = std::min(static_cast<double>(std::max(1, options.burst)),
+                              tokens + elapsed.count() * options.requestsPerSecond);
+            lastRefill = now;
+        }
+
+        void acquire(Lane &lane)
+        {
+            std::unique_lock<std::mutex> lk(mutex);
+            const std::uint64_t ticket = lane.nextTicket++;
+            for (;;)
+            {
+                if (ticket != lane.servingTicket || (lane.limit > 0 && lane.active >= lane.limit))
+                {
+                    cv.wait(lk);
+                    continue;
+                }
+                if (options.requestsPerSecond > 0.0)
+                {
+                    const auto now = Clock::now();
+                    refill(now);
+                    if (tokens < 1.0)
+                    {
+                        const auto wait = std::chrono::duration<double>((1.0 - tokens) / options.requestsPerSecond);
+                        cv.wait_until(lk, now + std::chrono::duration_cast<Clock::duration>(wait));
+                        continue;
+                    }
+                    tokens -= 1.0;
+                }
+                ++lane.active;
+                ++lane.servingTicket;
+                // The next ticket holder of this lane may be admissible right away.
+                cv.notify_all();
+                return;
+            }
+        }
+
+        void release(Lane &lane)
+        {
+            {
+                std::lock_guard<std::mutex> lk(mutex);
+                --lane.active;
+            }
+            cv.notify_all();
+        }
+    };
+
+    RateLimiter::Permit::Permit(std::shared_ptr<RateLimiterState> state, bool stream)
+        : _state(std::move(state)), _stream(stream)
+    {
+    }
+
+    RateLimiter::Permit::Permit(Permit &&other) noexcept
+        : _state(std::move(other._state)), _stream(other._stream)
+    {
+    }
+
+    RateLimiter::Permit &RateLimiter::Permit::operator=(Permit &&other) noexcept
+    {
+        if (this != &other)
+        {
+            release();
+            _state = std::move(other._state);
+            _stream = other._stream;
+        }
+        return *this;
+    }
+
+    RateLimiter::Permit::~Permit()
+    {
+        release();
+    }
+
+    void RateLimiter::Permit::release()
+    {
+        if (_state)
+        {
+            _state->release(_stream ? _state->streams : _state->requests);
+            _state.reset();
+        }
+    }
+
+    RateLimiter::RateLimiter(const RateLimiterOptions &options)
+        : _state(std::make_shared<RateLimiterState>())
+    {
+        _state->options = options;
+        _state->streams.limit = std::max(0, options.maxConcurrentStreams);
+        _state->requests.limit = std::max(0, options.maxInFlightRequests);
+        _state->tokens = static_cast<double>(std::max(1, options.burst));
+    }
+
+    RateLimiter::~RateLimiter() = default;
+
+    RateLimiter::Permit RateLimiter::acquireRequest()
+    {
+        _state->acquire(_state->requests);
+        return Permit(_state, false);
+    }
+
+    RateLimiter::Permit RateLimiter::acquireStream()
+    {
+        _state->acquire(_state->streams);
+        return Permit(_state, true);
+    }
+
+    int RateLimiter::activeStreams() const
+    {
+        std::lock_guard<std::mutex> lk(_state->mutex);
+        return _state->streams.active;
+    }
+
+    int RateLimiter::inFlightRequests() const
+    {
+        std::lock_guard<std::mutex> lk(_state->mutex);
+        return _state->requests.active;
+    }
+} // namespace deepgram
@@ -0,0 +1,230 @@
+#include "speak-cache.hpp"
+#include "impl/content-hash.hpp"
+#include "impl/lru-cache.hpp"
+#include "impl/mapped-file.hpp"
+#include <spdlog/spdlog.h>
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <mutex>
+#include <sstream>
+#include <system_error>
+#include <thread>
+
+namespace fs = std::filesystem;
+
+namespace deepgram
+{
+    namespace speak
+    {
+        namespace
+        {
+            constexpr const char *kFileSuffix = ".dgspeech";
+            constexpr char kMagic[8] = {'D', 'G', 'S', 'P', 'C', 'H', '0', '1'};
+
+            /**
+             * On-disk entry layout, all integers little-endian:
+             * magic[8] | keySize u32 | contentTypeSize u32 | audioSize u64 | key | contentType | audio
+             */
+            struct FileHeader
+            {
+                char magic[8];
+                std::uint32_t keySize;
+                std::uint32_t contentTypeSize;
+                std::uint64_t audioSize;
+            };
+            static_assert(sizeof(FileHeader) == 24, "FileHeader must be packed");
+        }
+
+        struct SpeechCacheState
+        {
+            SpeechCacheOptions options;
+            mutable std::mutex mutex;
+            LruCache<std::shared_ptr<const CachedSpeech>> memory;
+
+            fs::path pathFor(const std::string &key) const
+            {
+                return fs::path(options.directory) /
+                       (ContentHasher::toHex(ContentHasher::hash(key.data(), key.size(), 0)) +
+                        ContentHasher::toHex(ContentHasher::hash(key.data(), key.size(), 1)) + kFileSuffix);
+            }
+
+            std::shared_ptr<const CachedSpeech> readDisk(const std::string &key) const
+            {
+                const auto file = MappedFile::open(pathFor(key).string());
+                if (!file || file->size() < sizeof(FileHeader))
+                {
+                    return nullptr;
+                }
+                FileHeader header;
+                std::memcpy(&header, file->data(), sizeof(header));
+                const std::uint64_t expected = sizeof(header) + std::uint64_t(header.keySize) + header.contentTypeSize + header.audioSize;
+                if (std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0 || expected != file->size() ||
+                    header.keySize != key.size() ||
+                    std::memcmp(file->data() + sizeof(header), key.data(), key.size()) != 0)
+                {
+                    return nullptr;
+                }
+                const std::uint8_t *contentType = file->data() + sizeof(header) + header.keySize;
+                return std::make_shared<const CachedSpeech>(
+                    file, contentType + header.contentTypeSize, static_cast<std::size_t>(header.audioSize),
+                    std::string(reinterpret_cast<const char *>(contentType), header.contentTypeSize));
+            }
+
+            void writeDisk(const std::string &key, const CachedSpeech &speech) const
+            {
+                std::error_code ec;
+                fs::create_directories(options.directory, ec);
+                const fs::path path = pathFor(key);
+                // Write next to the final name and rename, so a mapped reader (or
+                // a crash) never sees a half-written entry.
+                fs::path tmp = path;
+                tmp += ".tmp" + std::to_string(std::hash<std::thread::id>{}(std::this_thread::get_id()));
+                {
+                    std::ofstream out(tmp, std::ios::binary | std::ios::trunc);
+                    if (!out)
+                    {
+                        spdlog::warn("can't write speech cache entry {}", tmp.string());
+                        return;
+                    }
+                    FileHeader header;
+                    std::memcpy(header.magic, kMagic, sizeof(kMagic));
+                    header.keySize = static_cast<std::uint32_t>(key.size());
+                    header.contentTypeSize = static_cast<std::uint32_t>(speech.contentType().size());
+                    header.audioSize = speech.size();
+                    out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+                    out.write(key.data(), static_cast<std::streamsize>(key.size()));
+                    out.write(speech.contentType().data(), static_cast<std::streamsize>(speech.contentType().size()));
+                    out.write(reinterpret_cast<const char *>(speech.data()), static_cast<std::streamsize>(speech.size()));
+                    if (!out)
+                    {
+                        out.close();
+                        fs::remove(tmp, ec);
+                        return;
+                    }
+                }
+                fs::rename(tmp, path, ec);
+                if (ec)
+                {
+                    spdlog::warn("can't store speech cache entry {}: {}", path.string(), ec.message());
+                    fs::remove(tmp, ec);
+                }
+            }
+        };
+
+        SpeechCache::SpeechCache(SpeechCacheOptions options)
+            : _state(std::make_unique<SpeechCacheState>())
+        {
+            _state->options = std::move(options);
+            _state->memory.setCapacity(_state->options.maxMemoryBytes);
+        }
+
+        SpeechCache::~SpeechCache() = default;
+
+        std::string SpeechCache::makeKey(const std::string &text, const LiveSpeakConfig &config, SpeechSource source)
+        {
+            std::ostringstream oss;
+            oss << (source == SpeechSource::Rest ? "rest" : "ws") << '|' << config.model << '|' << config.encoding << '|';
+            if (config.sampleRate)
+            {
+                oss << *config.sampleRate;
+            }
+            oss << '|';
+            if (config.bitrate)
+            {
+                oss << *config.bitrate;
+            }
+            oss << '|' << config.container.value_or("") << '|';
+            if (config.speed)
+            {
+                oss << *config.speed;
+            }
+            oss << '\n'
+                << text;
+            return oss.str();
+        }
+
+        std::string SpeechCache::streamContentType(const LiveSpeakConfig &config)
+        {
+            if (config.encoding == "linear16")
+            {
+                return config.sampleRate ? "audio/L16;rate=" + std::to_string(*config.sampleRate) : "audio/L16";
+            }
+            if (config.encoding == "mulaw")
+            {
+                return "audio/PCMU";
+            }
+            if (config.encoding == "alaw")
+            {
+                return "audio/PCMA";
+            }
+            return "application/octet-stream";
+        }
+
+        std::shared_ptr<const CachedSpeech> SpeechCache::get(const std::string &key)
+        {
+            {
+                std::lock_guard<std::mutex> lk(_state->mutex);
+                if (const auto *cached = _state->memory.find(key))
+                {
+                    return *cached;
+                }
+            }
+            if (_state->options.directory.empty())
+            {
+                return nullptr;
+            }
+
+            auto speech = _state->readDisk(key);
+            if (speech)
+            {
+                std::lock_guard<std::mutex> lk(_state->mutex);
+                _state->memory.put(key, speech, speech->size());
+            }
+            return speech;
+        }
+
+        void SpeechCache::put(const std::string &key, std::vector<std::uint8_t> audio, const std::string &contentType)
+        {
+            auto buffer = std::make_shared<const std::vector<std::uint8_t>>(std::move(audio));
+            auto speech = std::make_shared<const CachedSpeech>(buffer, buffer->data(), buffer->size(), contentType);
+            {
+                std::lock_guard<std::mutex> lk(_state->mutex);
+                _state->memory.put(key, speech, speech->size());
+            }
+            if (!_state->options.directory.empty())
+            {
+                _state->writeDisk(key, *speech);
+            }
+        }
+
+        void SpeechCache::clear()
+        {
+            {
+                std::lock_guard<std::mutex> lk(_state->mutex);
+                _state->memory.clear();
+            }
+            if (_state->options.directory.empty())
+            {
+                return;
+            }
+            std::error_code ec;
+            for (fs::directory_iterator it(_state->options.directory, ec), end; !ec && it != end; it.increment(ec))
+            {
+                if (it->path().extension() == kFileSuffix)
+                {
+                    std::error_code removeError;
+                    fs::remove(it->path(), removeError);
+                }
+            }
+        }
+
+        std::size_t SpeechCache::memoryBytes() const
+        {
+            std::lock_guard<std::mutex> lk(_state->mutex);
+            return _state->memory.totalCost();
+        }
+    }
+}
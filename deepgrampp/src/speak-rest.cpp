@@ -22,3 +22,33 @@ SpeakRestResult SpeakRestClient::speak(const std::string &text, const LiveSpeakC
     }
     return impl_->speak(text, config);
 }
+
+void SpeakRestClient::setRetryPolicy(const RetryPolicy &policy)
+{
+    if (!impl_)
+    {
+        spdlog::error("can't set retry policy, SpeakRestClientImpl is not initialized");
+        return;
+    }
+    impl_->setRetryPolicy(policy);
+}
+
+void SpeakRestClient::setRateLimiter(std::shared_ptr<RateLimiter> rateLimiter)
+{
+    if (!impl_)
+    {
+        spdlog::error("can't set rate limiter, SpeakRestClientImpl is not initialized");
+        return;
+    }
+    impl_->setRateLimiter(std::move(rateLimiter));
+}
+
+void SpeakRestClient::setSpeechCache(std::shared_ptr<SpeechCache> cache)
+{
+    if (!impl_)
+    {
+        spdlog::error("can't set speech cache, SpeakRestClientImpl is not initialized");
+        return;
+    }
+    impl_->setSpeechCache(std::move(cache));
+}
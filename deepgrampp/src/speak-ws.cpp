@@ -19,24 +19,13 @@ deepgram::speak::SpeakWebsocketClient::SpeakWebsocketClient(const std::string &a
         },
         [this](const std::string &message)
         {
-            nlohmann::json jsonResponse = nlohmann::json::parse(message);
-            if (jsonResponse.contains("type"))
+            try
             {
-                if (jsonResponse["type"] == "Metadata")
-                {
-                    if (_speechMetadataResponseCallback)
-                    {
-                        _speechMetadataResponseCallback(MetadataResponse::fromJson(jsonResponse));
-                    }
-                }
-                else if (_speechControlResponseCallback)
-                {
-                    _speechControlResponseCallback(SpeakControlResponse::fromJson(jsonResponse));
-                }
+                _speakWebsocketClientImpl->router().route(message);
             }
-            else if (_speechCloseFrameCallback)
+            catch (const std::exception &e)
             {
-                _speechCloseFrameCallback(SpeakCloseFrame::fromJson(jsonResponse));
+                spdlog::error("Error handling speak message: {}, error: {}", message, e.what());
             }
         },
         [this](const std::string &errorMessage)
@@ -59,6 +48,49 @@ deepgram::speak::SpeakWebsocketClient::SpeakWebsocketClient(const std::string &a
             {
                 _speechStartedCallback();
             }
+        },
+        [this]()
+        {
+            if (_speechEndedCallback)
+            {
+                _speechEndedCallback();
+            }
+        });
+
+    // Each message is decoded once, by its own decoder, and only when someone
+    // needs it. "Flushed" and "Cleared" are always decoded: end-of-speech
+    // detection and the speech cache track them.
+    MessageRouter &router = _speakWebsocketClientImpl->router();
+    router.add(
+        "Metadata",
+        [this]()
+        { return static_cast<bool>(_speechMetadataResponseCallback); },
+        [this](const std::string &message)
+        { _speechMetadataResponseCallback(MetadataResponse::fromJson(nlohmann::json::parse(message))); });
+    const auto onTrackedControlResponse = [this](const std::string &message)
+    {
+        const SpeakControlResponse response = SpeakControlResponse::fromJson(nlohmann::json::parse(message));
+        _speakWebsocketClientImpl->onControlResponse(response.type);
+        if (_speechControlResponseCallback)
+        {
+            _speechControlResponseCallback(response);
+        }
+    };
+    router.add("Flushed", nullptr, onTrackedControlResponse);
+    router.add("Cleared", nullptr, onTrackedControlResponse);
+    router.setFallback(
+        [this](const std::string &message, std::optional<std::string_view> type)
+        {
+            // Other control responses ("Cleared", "Warning", ...) carry a type;
+            // the close frame is the one message without.
+            if (type && _speechControlResponseCallback)
+            {
+                _speechControlResponseCallback(SpeakControlResponse::fromJson(nlohmann::json::parse(message)));
+            }
+            else if (!type && _speechCloseFrameCallback)
+            {
+                _speechCloseFrameCallback(SpeakCloseFrame::fromJson(nlohmann::json::parse(message)));
+            }
         });
 }
 
@@ -79,7 +111,7 @@ void deepgram::speak::SpeakWebsocketClient::close()
 {
     // Always delegate: SpeakWebsocketClientImpl::close() safely no-ops the
     // network teardown when already disconnected, but still must run so the
-    // speech-timeout monitor thread gets joined.
+    // end-of-speech fallback timer gets cancelled.
     if (_speakWebsocketClientImpl) {
         _speakWebsocketClientImpl->close();
     } else {
@@ -89,29 +121,15 @@ void deepgram::speak::SpeakWebsocketClient::close()
 
 void deepgram::speak::SpeakWebsocketClient::startReceiving()
 {
-    // Message/audio callbacks are already wired up (see constructor). The only
-    // thing that still needs an explicit "connected" starting point is the
-    // end-of-speech idle-timeout monitor, since it polls _wsTransport->isOpen().
-    if (_speakWebsocketClientImpl && _speakWebsocketClientImpl->isConnected()) {
-        _speakWebsocketClientImpl->startSpeechTimeoutMonitor(
-            [this]() {
-                if (_speechEndedCallback) {
-                    _speechEndedCallback();
-                }
-            });
-    } else {
-        spdlog::error("can't start receiving, SpeakWebsocketClientImpl is not initialized");
-    }
+    // No-op: message/audio callbacks are wired up in the constructor, and
+    // end-of-speech detection is driven by the audio and Flushed responses
+    // themselves.
 }
 
 bool deepgram::speak::SpeakWebsocketClient::speak(const std::string &text)
 {
     if (_speakWebsocketClientImpl && _speakWebsocketClientImpl->isConnected()) {
-        nlohmann::json speakMessage = {
-            {"type", "Speak"},
-            {"text", text}
-        };
-        return _speakWebsocketClientImpl->sendPayload(speakMessage.dump());
+        return _speakWebsocketClientImpl->speak(text);
     } else {
         spdlog::error("can't send text, SpeakWebsocketClientImpl is not initialized");
         return false;
@@ -121,7 +139,7 @@ bool deepgram::speak::SpeakWebsocketClient::speak(const std::string &text)
 bool deepgram::speak::SpeakWebsocketClient::sendFlushMessage()
 {
     if(_speakWebsocketClientImpl && _speakWebsocketClientImpl->isConnected()) {
-        return _speakWebsocketClientImpl->sendPayload(speak::control::FLUSH);
+        return _speakWebsocketClientImpl->flush();
     } else {
         spdlog::error("can't send flush message, SpeakWebsocketClientImpl is not initialized");
         return false;
@@ -131,7 +149,7 @@ bool deepgram::speak::SpeakWebsocketClient::sendFlushMessage()
 bool deepgram::speak::SpeakWebsocketClient::sendClearMessage()
 {
     if (_speakWebsocketClientImpl && _speakWebsocketClientImpl->isConnected()) {
-        return _speakWebsocketClientImpl->sendPayload(speak::control::CLEAR);
+        return _speakWebsocketClientImpl->clear();
     } else {
         spdlog::error("can't send clear message, SpeakWebsocketClientImpl is not initialized");
         return false;
@@ -194,3 +212,33 @@ void deepgram::speak::SpeakWebsocketClient::setSpeechReceptionTimeout(int timeou
         _speakWebsocketClientImpl->setSpeechReceptionTimeout(timeoutMs);
     }
 }
+
+void deepgram::speak::SpeakWebsocketClient::setCloseTimeout(std::chrono::milliseconds timeout)
+{
+    if (_speakWebsocketClientImpl) {
+        _speakWebsocketClientImpl->setCloseTimeout(timeout);
+    }
+}
+
+void deepgram::speak::SpeakWebsocketClient::setRateLimiter(std::shared_ptr<RateLimiter> rateLimiter)
+{
+    if (!_speakWebsocketClientImpl) {
+        spdlog::error("can't set rate limiter, SpeakWebsocketClientImpl is not initialized");
+        return;
+    }
+    _speakWebsocketClientImpl->setRateLimiter(std::move(rateLimiter));
+}
+
+void deepgram::speak::SpeakWebsocketClient::setDecodeToLinear16(bool decode)
+{
+    if (_speakWebsocketClientImpl) {
+        _speakWebsocketClientImpl->setDecodeToLinear16(decode);
+    }
+}
+
+void deepgram::speak::SpeakWebsocketClient::setSpeechCache(std::shared_ptr<SpeechCache> cache)
+{
+    if (_speakWebsocketClientImpl) {
+        _speakWebsocketClientImpl->setSpeechCache(std::move(cache));
+    }
+}
@@ -0,0 +1,412 @@
+#include "word-timeline.hpp"
+
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <charconv>
+#include <functional>
+#include <stdexcept>
+
+namespace deepgram
+{
+    namespace listen
+    {
+        namespace
+        {
+            std::int32_t parseSpeaker(std::string_view text)
+            {
+                std::int32_t speaker = WordTimeline::kNoSpeaker;
+                const auto parsed = std::from_chars(text.data(), text.data() + text.size(), speaker);
+                return parsed.ec == std::errc() ? speaker : WordTimeline::kNoSpeaker;
+            }
+
+            /**
+             * Appends the words of one channel/alternative to a WordTimeline as
+             * they stream past, skipping everything else.
+             */
+            class TimelineSax
+            {
+            public:
+                using number_integer_t = nlohmann::json::number_integer_t;
+                using number_unsigned_t = nlohmann::json::number_unsigned_t;
+                using number_float_t = nlohmann::json::number_float_t;
+                using string_t = nlohmann::json::string_t;
+                using binary_t = nlohmann::json::binary_t;
+
+                TimelineSax(WordTimeline &timeline, std::size_t channel, std::size_t alternative)
+                    : _timeline(timeline), _channel(channel), _alternative(alternative)
+                {
+                    _stack.reserve(12);
+                }
+
+                bool null() { return true; }
+                bool boolean(bool) { return true; }
+                bool binary(binary_t &) { return true; }
+
+                bool number_integer(number_integer_t value)
+                {
+                    number(static_cast<double>(value));
+                    if (parent() == Node::Word && _key == "speaker")
+                    {
+                        _speaker = static_cast<std::int32_t>(value);
+                    }
+                    return true;
+                }
+
+                bool number_unsigned(number_unsigned_t value)
+                {
+                    return number_integer(static_cast<number_integer_t>(value));
+                }
+
+                bool number_float(number_float_t value, const string_t &)
+                {
+                    number(value);
+                    return true;
+                }
+
+                bool string(string_t &value)
+                {
+                    if (parent() != Node::Word)
+                    {
+                        return true;
+                    }
+                    if (_key == "word")
+                    {
+                        _word.swap(value);
+                    }
+                    else if (_key == "punctuated_word")
+                    {
+                        _punctuatedWord.swap(value);
+                    }
+                    else if (_key == "speaker")
+                    {
+                        _speaker = parseSpeaker(value);
+                    }
+                    return true;
+                }
+
+                bool start_object(std::size_t)
+                {
+                    Node node = Node::Other;
+                    const Node outer = parent();
+                    if (_stack.empty())
+                    {
+                        node = Node::Root;
+                    }
+                    else if (outer == Node::Root && _key == "results")
+                    {
+                        node = Node::Results;
+                    }
+                    else if ((outer == Node::Channels) || (outer == Node::Root && _key == "channel"))
+                    {
+                        node = Node::Channel;
+                        _inChannel = _channelCount++ == _channel;
+                    }
+                    else if (outer == Node::Alternatives)
+                    {
+                        node = Node::Alternative;
+                        _inAlternative = _inChannel && _alternativeCount++ == _alternative;
+                    }
+                    else if (outer == Node::Words)
+                    {
+                        node = Node::Word;
+                        _word.clear();
+                        _punctuatedWord.clear();
+                        _start = _end = 0.0;
+                        _confidence = 0.0f;
+                        _speaker = WordTimeline::kNoSpeaker;
+                    }
+                    _stack.push_back(node);
+                    return true;
+                }
+
+                bool end_object()
+                {
+                    if (parent() == Node::Word)
+                    {
+                        _timeline.append(_word, _start, _end, _confidence, _speaker, _punctuatedWord);
+                    }
+                    _stack.pop_back();
+                    return true;
+                }
+
+                bool start_array(std::size_t)
+                {
+                    Node node = Node::Other;
+                    const Node outer = parent();
+                    if (outer == Node::Results && _key == "channels")
+                    {
+                        node = Node::Channels;
+                        _channelCount = 0;
+                    }
+                    else if (outer == Node::Channel && _key == "alternatives")
+                    {
+                        node = Node::Alternatives;
+                        _alternativeCount = 0;
+                    }
+                    else if (outer == Node::Alternative && _key == "words" && _inAlternative)
+                    {
+                        node = Node::Words;
+                    }
+                    _stack.push_back(node);
+                    return true;
+                }
+
+                bool end_array()
+                {
+                    _stack.pop_back();
+                    return true;
+                }
+
+                bool key(string_t &value)
+                {
+                    _key.assign(value);
+                    return true;
+                }
+
+                bool parse_error(std::size_t position, const std::string &, const nlohmann::detail::exception &e)
+                {
+                    throw std::runtime_error("invalid JSON at byte " + std::to_string(position) + ": " + e.what());
+                }
+
+            private:
+                enum class Node : std::uint8_t
+                {
+                    None,
+                    Root,
+                    Results,
+                    Channels,
+                    Channel,
+                    Alternatives,
+                    Alternative,
+                    Words,
+                    Word,
+                    Other
+                };
+
+                Node parent() const
+                {
+                    return _stack.empty() ? Node::None : _stack.back();
+                }
+
+                void number(double value)
+                {
+                    if (parent() != Node::Word)
+                    {
+                        return;
+                    }
+                    if (_key == "start")
+                    {
+                        _start = value;
+                    }
+                    else if (_key == "end")
+                    {
+                        _end = value;
+                    }
+                    else if (_key == "confidence")
+                    {
+                        _confidence = static_cast<float>(value);
+                    }
+                }
+
+                WordTimeline &_timeline;
+                const std::size_t _channel;
+                const std::size_t _alternative;
+                std::vector<Node> _stack;
+                std::string _key;
+
+                std::size_t _channelCount = 0;
+                std::size_t _alternativeCount = 0;
+                bool _inChannel = false;
+                bool _inAlternative = false;
+
+                std::string _word;
+                std::string _punctuatedWord;
+                double _start = 0.0;
+                double _end = 0.0;
+                float _confidence = 0.0f;
+                std::int32_t _speaker = WordTimeline::kNoSpeaker;
+            };
+        }
+
+        WordTimeline WordTimeline::fromResponse(const PrerecordedTranscriptionResponse &response,
+                                                std::size_t channel, std::size_t alternative)
+        {
+            WordTimeline timeline;
+            if (channel < response.channels.size() && alternative < response.channels[channel].alternatives.size())
+            {
+                timeline.append(response.channels[channel].alternatives[alternative]);
+            }
+            return timeline;
+        }
+
+        WordTimeline WordTimeline::parse(const std::string &json, std::size_t channel, std::size_t alternative)
+        {
+            WordTimeline timeline;
+            TimelineSax handler(timeline, channel, alternative);
+            nlohmann::json::sax_parse(json, &handler);
+            return timeline;
+        }
+
+        void WordTimeline::append(const Alternative &alt)
+        {
+            reserve(size() + alt.words.size());
+            for (const auto &w : alt.words)
+            {
+                append(w.word, w.start, w.end, static_cast<float>(w.confidence),
+                       w.speaker ? parseSpeaker(*w.speaker) : kNoSpeaker,
+                       w.punctuated_word ? std::string_view(*w.punctuated_word) : std::string_view());
+            }
+        }
+
+        void WordTimeline::append(std::string_view word, double start, double end, float confidence,
+                                  std::int32_t speaker, std::string_view punctuatedWord)
+        {
+            _starts.push_back(start);
+            _ends.push_back(end);
+            _confidences.push_back(confidence);
+            _speakers.push_back(speaker);
+            _wordIds.push_back(intern(word));
+            _punctuatedIds.push_back(punctuatedWord.empty() ? kNoText : intern(punctuatedWord));
+        }
+
+        void WordTimeline::reserve(std::size_t words)
+        {
+            _starts.reserve(words);
+            _ends.reserve(words);
+            _confidences.reserve(words);
+            _speakers.reserve(words);
+            _wordIds.reserve(words);
+            _punctuatedIds.reserve(words);
+        }
+
+        void WordTimeline::clear()
+        {
+            *this = WordTimeline();
+        }
+
+        std::uint32_t WordTimeline::intern(std::string_view text)
+        {
+            const std::size_t hash = std::hash<std::string_view>{}(text);
+            const auto matches = _textIndex.equal_range(hash);
+            for (auto it = matches.first; it != matches.second; ++it)
+            {
+                if (this->text(it->second) == text)
+                {
+                    return it->second;
+                }
+            }
+            const auto id = static_cast<std::uint32_t>(_textOffsets.size() - 1);
+            _pool.append(text.data(), text.size());
+            _textOffsets.push_back(static_cast<std::uint32_t>(_pool.size()));
+            _textIndex.emplace(hash, id);
+            return id;
+        }
+
+        std::string_view WordTimeline::text(std::uint32_t id) const
+        {
+            if (id == kNoText || id + 1 >= _textOffsets.size())
+            {
+                return {};
+            }
+            return std::string_view(_pool).substr(_textOffsets[id], _textOffsets[id + 1] - _textOffsets[id]);
+        }
+
+        std::string_view WordTimeline::punctuatedWord(std::size_t index) const
+        {
+            return _punctuatedIds[index] != kNoText ? text(_punctuatedIds[index]) : text(_wordIds[index]);
+        }
+
+        std::uint32_t WordTimeline::find(std::string_view text) const
+        {
+            const auto matches = _textIndex.equal_range(std::hash<std::string_view>{}(text));
+            for (auto it = matches.first; it != matches.second; ++it)
+            {
+                if (this->text(it->second) == text)
+                {
+                    return it->second;
+                }
+            }
+            return kNoText;
+        }
+
+        WordTimeline::Range WordTimeline::between(double from, double to) const
+        {
+            // First word still running at `from`, and first word starting at or after `to`.
+            const auto first = std::upper_bound(_ends.begin(), _ends.end(), from) - _ends.begin();
+            const auto last = std::lower_bound(_starts.begin(), _starts.end(), to) - _starts.begin();
+            return Range{static_cast<std::size_t>(first), static_cast<std::size_t>(std::max(first, last))};
+        }
+
+        std::vector<std::size_t> WordTimeline::wordsOfSpeaker(std::int32_t speaker, Range range) const
+        {
+            std::vector<std::size_t> indices;
+            const std::int32_t *speakers = _speakers.data();
+            for (std::size_t i = range.begin; i < range.end; ++i)
+            {
+                if (speakers[i] == speaker)
+                {
+                    indices.push_back(i);
+                }
+            }
+            return indices;
+        }
+
+        // The aggregates below are written branch-free over raw column
+        // pointers so the compiler can vectorize them (the floating-point sums
+        // only where it may reassociate, e.g. with -ffast-math).
+
+        double WordTimeline::speakingTime(std::int32_t speaker, Range range) const
+        {
+            const double *starts = _starts.data();
+            const double *ends = _ends.data();
+            const std::int32_t *speakers = _speakers.data();
+            double total = 0.0;
+            for (std::size_t i = range.begin; i < range.end; ++i)
+            {
+                total += speakers[i] == speaker ? ends[i] - starts[i] : 0.0;
+            }
+            return total;
+        }
+
+        double WordTimeline::meanConfidence(Range range) const
+        {
+            if (range.empty())
+            {
+                return 0.0;
+            }
+            const float *confidences = _confidences.data();
+            double total = 0.0;
+            for (std::size_t i = range.begin; i < range.end; ++i)
+            {
+                total += confidences[i];
+            }
+            return total / static_cast<double>(range.size());
+        }
+
+        std::size_t WordTimeline::countBelow(float threshold, Range range) const
+        {
+            const float *confidences = _confidences.data();
+            std::size_t count = 0;
+            for (std::size_t i = range.begin; i < range.end; ++i)
+            {
+                count += confidences[i] < threshold ? 1 : 0;
+            }
+            return count;
+        }
+
+        std::string WordTimeline::joinedText(Range range, bool punctuated) const
+        {
+            std::string joined;
+            for (std::size_t i = range.begin; i < range.end; ++i)
+            {
+                if (i != range.begin)
+                {
+                    joined += ' ';
+                }
+                joined += punctuated ? punctuatedWord(i) : word(i);
+            }
+            return joined;
+        }
+    }
+}
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <curl/curl.h>
+
+#include <stdexcept>
+
+namespace deepgram
+{
+    namespace transport
+    {
+        /**
+         * Runs curl_global_init() exactly once per process. Shared by every libcurl
+         * user in this library (transports and share contexts alike) since it must
+         * happen before the first easy *or* share handle is created.
+         */
+        inline void ensureCurlGlobalInit()
+        {
+            static const int curlGlobalInitResult = []
+            { return curl_global_init(CURL_GLOBAL_DEFAULT); }();
+
+            if (curlGlobalInitResult != CURLE_OK)
+            {
+                throw std::runtime_error("[deepgrampp] curl_global_init failed");
+            }
+        }
+
+    } // namespace transport
+} // namespace deepgram
@@ -1,9 +1,12 @@
 #include <deepgrampp/transport/curl_http_transport.hpp>
 
+#include "curl_global_init.hpp"
+
 #include <curl/curl.h>
 
 #include <algorithm>
 #include <cctype>
+#include <memory>
 #include <stdexcept>
 #include <string>
 
@@ -72,28 +75,90 @@ namespace deepgram
                 return bytes;
             }
 
+            struct SlistDeleter
+            {
+                void operator()(curl_slist *list) const
+                {
+                    curl_slist_free_all(list);
+                }
+            };
+
+            using SlistPtr = std::unique_ptr<curl_slist, SlistDeleter>;
+
+            void appendHeader(SlistPtr &list, const std::string &header)
+            {
+                // On failure curl_slist_append() returns null and leaves the
+                // list as it was, still owned by `list`.
+                curl_slist *appended = curl_slist_append(list.get(), header.c_str());
+                if (appended == nullptr)
+                {
+                    throw std::runtime_error("[deepgrampp] curl_slist_append failed");
+                }
+                list.release();
+                list.reset(appended);
+            }
+
         } // namespace
 
-        CurlHttpTransport::CurlHttpTransport(std::string caFilePath)
-            : _caFilePath(std::move(caFilePath))
+        CurlHttpTransport::CurlHttpTransport(std::string caFilePath,
+                                             std::shared_ptr<CurlShareContext> shareContext)
+            : _caFilePath(std::move(caFilePath)), _shareContext(std::move(shareContext))
         {
         }
 
-        HttpResponse CurlHttpTransport::send(const HttpRequest &request)
+        CurlHttpTransport::~CurlHttpTransport()
         {
-            static const int curlGlobalInitResult = []
-            { return curl_global_init(CURL_GLOBAL_DEFAULT); }();
+            for (void *handle : _idleHandles)
+            {
+                curl_easy_cleanup(static_cast<CURL *>(handle));
+            }
+        }
 
-            if (curlGlobalInitResult != CURLE_OK)
+        void *CurlHttpTransport::acquireHandle()
+        {
             {
-                throw std::runtime_error("[deepgrampp] curl_global_init failed");
+                std::lock_guard<std::mutex> lk(_poolMutex);
+                if (!_idleHandles.empty())
+                {
+                    void *handle = _idleHandles.back();
+                    _idleHandles.pop_back();
+                    return handle;
+                }
             }
 
+            ensureCurlGlobalInit();
             CURL *curl = curl_easy_init();
             if (curl == nullptr)
             {
                 throw std::runtime_error("[deepgrampp] curl_easy_init failed");
             }
+            return curl;
+        }
+
+        void CurlHttpTransport::releaseHandle(void *handle)
+        {
+            // curl_easy_reset() drops every option set for the previous request
+            // but keeps the handle's live connections and caches, which is the
+            // whole point of pooling it.
+            curl_easy_reset(static_cast<CURL *>(handle));
+            {
+                std::lock_guard<std::mutex> lk(_poolMutex);
+                if (_idleHandles.size() < kMaxIdleHandles)
+                {
+                    _idleHandles.push_back(handle);
+                    return;
+                }
+            }
+            curl_easy_cleanup(static_cast<CURL *>(handle));
+        }
+
+        HttpResponse CurlHttpTransport::send(const HttpRequest &request)
+        {
+            // Goes back to the pool however send() exits.
+            const auto release = [this](CURL *handle)
+            { releaseHandle(handle); };
+            const std::unique_ptr<CURL, decltype(release)> handle(static_cast<CURL *>(acquireHandle()), release);
+            CURL *curl = handle.get();
 
             CurlResponseContext ctx;
 
@@ -103,6 +168,14 @@ namespace deepgram
             curl_easy_setopt(curl, CURLOPT_HEADERFUNCTION, writeHeaderCallback);
             curl_easy_setopt(curl, CURLOPT_HEADERDATA, &ctx);
             curl_easy_setopt(curl, CURLOPT_FOLLOWLOCATION, 1L);
+            // Easy handles are used from arbitrary worker threads; without this,
+            // curl's default resolver may signal() on timeouts.
+            curl_easy_setopt(curl, CURLOPT_NOSIGNAL, 1L);
+
+            if (_shareContext)
+            {
+                curl_easy_setopt(curl, CURLOPT_SHARE, static_cast<CURLSH *>(_shareContext->nativeHandle()));
+            }
 
             // mbedTLS (our TLS backend everywhere except Windows) ships with no built-in
             // trust anchors, so without an explicit CA file every handshake fails with
@@ -150,31 +223,25 @@ namespace deepgram
                 break;
             }
 
-            curl_slist *headerList = nullptr;
+            // Declared after the handle, so it's freed before the handle is
+            // reset and pooled.
+            SlistPtr headerList;
             for (const auto &[key, value] : request.headers)
             {
-                const std::string item = key + ": " + value;
-                headerList = curl_slist_append(headerList, item.c_str());
+                appendHeader(headerList, key + ": " + value);
             }
             if (!request.content_type.empty())
             {
-                const std::string ct = "Content-Type: " + request.content_type;
-                headerList = curl_slist_append(headerList, ct.c_str());
+                appendHeader(headerList, "Content-Type: " + request.content_type);
             }
-            if (headerList != nullptr)
+            if (headerList)
             {
-                curl_easy_setopt(curl, CURLOPT_HTTPHEADER, headerList);
+                curl_easy_setopt(curl, CURLOPT_HTTPHEADER, headerList.get());
             }
 
             const CURLcode rc = curl_easy_perform(curl);
             curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &ctx.response.status_code);
 
-            if (headerList != nullptr)
-            {
-                curl_slist_free_all(headerList);
-            }
-            curl_easy_cleanup(curl);
-
             if (rc != CURLE_OK)
             {
                 throw std::runtime_error(std::string("[deepgrampp] curl perform failed: ") + curl_easy_strerror(rc));
@@ -0,0 +1,94 @@
+#include <deepgrampp/transport/curl_share_context.hpp>
+
+#include "curl_global_init.hpp"
+
+#include <curl/curl.h>
+#include <spdlog/spdlog.h>
+
+#include <array>
+#include <mutex>
+#include <stdexcept>
+
+namespace deepgram
+{
+    namespace transport
+    {
+        struct CurlShareContextImpl
+        {
+            CURLSH *_share{nullptr};
+            // One lock per curl_lock_data kind, so e.g. a DNS lookup on one thread
+            // doesn't serialize against a TLS-session lookup on another.
+            std::array<std::mutex, CURL_LOCK_DATA_LAST> _locks;
+        };
+
+        namespace
+        {
+            void lockCallback(CURL * /*handle*/, curl_lock_data data, curl_lock_access /*access*/, void *userptr)
+            {
+                auto *impl = static_cast<CurlShareContextImpl *>(userptr);
+                impl->_locks[static_cast<std::size_t>(data)].lock();
+            }
+
+            void unlockCallback(CURL * /*handle*/, curl_lock_data data, void *userptr)
+            {
+                auto *impl = static_cast<CurlShareContextImpl *>(userptr);
+                impl->_locks[static_cast<std::size_t>(data)].unlock();
+            }
+
+        } // namespace
+
+        CurlShareContext::CurlShareContext()
+            : _impl(std::make_unique<CurlShareContextImpl>())
+        {
+            ensureCurlGlobalInit();
+
+            _impl->_share = curl_share_init();
+            if (_impl->_share == nullptr)
+            {
+                throw std::runtime_error("[deepgrampp] curl_share_init failed");
+            }
+
+            if (curl_share_setopt(_impl->_share, CURLSHOPT_LOCKFUNC, lockCallback) != CURLSHE_OK ||
+                curl_share_setopt(_impl->_share, CURLSHOPT_UNLOCKFUNC, unlockCallback) != CURLSHE_OK ||
+                curl_share_setopt(_impl->_share, CURLSHOPT_USERDATA, _impl.get()) != CURLSHE_OK)
+            {
+                curl_share_cleanup(_impl->_share);
+                throw std::runtime_error("[deepgrampp] can't install the curl share lock callbacks");
+            }
+
+            // The connection cache is deliberately not shared: libcurl doesn't
+            // support using a shared connection cache from concurrent threads,
+            // which is exactly how transports on worker threads would use it.
+            // Each pooled easy handle keeps its own connections instead.
+            for (const curl_lock_data data : {CURL_LOCK_DATA_DNS, CURL_LOCK_DATA_SSL_SESSION})
+            {
+                const CURLSHcode rc = curl_share_setopt(_impl->_share, CURLSHOPT_SHARE, data);
+                if (rc != CURLSHE_OK)
+                {
+                    spdlog::warn("libcurl can't share data kind {}: {}", static_cast<int>(data), curl_share_strerror(rc));
+                }
+            }
+        }
+
+        CurlShareContext::~CurlShareContext()
+        {
+            if (_impl->_share != nullptr)
+            {
+                curl_share_cleanup(_impl->_share);
+                _impl->_share = nullptr;
+            }
+        }
+
+        std::shared_ptr<CurlShareContext> CurlShareContext::processWide()
+        {
+            static const std::shared_ptr<CurlShareContext> instance = std::make_shared<CurlShareContext>();
+            return instance;
+        }
+
+        void *CurlShareContext::nativeHandle() const
+        {
+            return _impl->_share;
+        }
+
+    } // namespace transport
+} // namespace deepgram
@@ -51,6 +51,15 @@ namespace deepgram
             };
             std::mutex _queueMutex;
             std::queue<OutboundMsg> _sendQueue;
+            // Frame buffers (LWS_PRE headroom included) recycled once written,
+            // so steady-state sends don't allocate. Guarded by _queueMutex.
+            std::vector<std::vector<unsigned char>> _bufferPool;
+
+            // Pull-mode binary frames (setBinaryFrameSource). The source and
+            // its buffer are guarded by _queueMutex.
+            IWebSocketTransport::BinaryFrameSource _frameSource;
+            std::vector<unsigned char> _pullBuffer;
+            std::atomic<bool> _pullRequested{false};
 
             std::atomic<bool> _closing{false};
 
@@ -87,6 +96,7 @@ namespace deepgram
                 impl->_stopping.store(false);
                 impl->_closing.store(false);
                 impl->_isOpen.store(false);
+                impl->_pullRequested.store(false);
                 impl->_connectDone = false;
                 impl->_connectFailed = false;
                 impl->_connectError.clear();
@@ -99,6 +109,59 @@ namespace deepgram
                 impl->_sendQueue.swap(emptyQueue);
             }
 
+            constexpr std::size_t kMaxPooledBuffers = 32;
+            constexpr std::size_t kMaxPooledBufferBytes = 256 * 1024;
+            constexpr std::size_t kPullFrameBytes = 64 * 1024;
+
+            void enqueue(LwsWebSocketTransportImpl *impl, bool isBinary, const void *data, std::size_t size)
+            {
+                LwsWebSocketTransportImpl::OutboundMsg msg;
+                msg.is_binary = isBinary;
+                {
+                    std::lock_guard<std::mutex> lk(impl->_queueMutex);
+                    if (!impl->_bufferPool.empty())
+                    {
+                        msg.data = std::move(impl->_bufferPool.back());
+                        impl->_bufferPool.pop_back();
+                    }
+                }
+                msg.data.resize(LWS_PRE + size);
+                if (size > 0)
+                {
+                    std::memcpy(msg.data.data() + LWS_PRE, data, size);
+                }
+
+                {
+                    std::lock_guard<std::mutex> lk(impl->_queueMutex);
+                    impl->_sendQueue.push(std::move(msg));
+                }
+                lws_cancel_service(impl->_ctx);
+            }
+
+            // Caller holds _queueMutex.
+            void recycle(LwsWebSocketTransportImpl *impl, std::vector<unsigned char> &&buffer)
+            {
+                if (impl->_bufferPool.size() < kMaxPooledBuffers && buffer.capacity() <= kMaxPooledBufferBytes)
+                {
+                    impl->_bufferPool.push_back(std::move(buffer));
+                }
+            }
+
+            // Writes one whole frame from `data`, which has LWS_PRE bytes of
+            // headroom before it. On failure marks the connection as closing.
+            bool writeFrame(LwsWebSocketTransportImpl *impl, lws *wsi, unsigned char *data, std::size_t size, bool isBinary)
+            {
+                const int written = lws_write(wsi, data, size, isBinary ? LWS_WRITE_BINARY : LWS_WRITE_TEXT);
+                if (written < 0 || static_cast<std::size_t>(written) != size)
+                {
+                    impl->_closing.store(true);
+                    impl->_isOpen.store(false);
+                    emitError(impl, "[deepgrampp] lws_write failed");
+                    return false;
+                }
+                return true;
+            }
+
             void cleanupConnection(LwsWebSocketTransportImpl *impl)
             {
                 impl->_stopping.store(true);
@@ -311,24 +374,30 @@ namespace deepgram
                 if (!impl->_sendQueue.empty())
                 {
                     auto &msg = impl->_sendQueue.front();
-                    const size_t paylen = msg.data.size() - LWS_PRE;
-                    const int written = lws_write(wsi,
-                                                  msg.data.data() + LWS_PRE,
-                                                  paylen,
-                                                  msg.is_binary ? LWS_WRITE_BINARY : LWS_WRITE_TEXT);
-                    if (written < 0 || static_cast<size_t>(written) != paylen)
+                    if (!writeFrame(impl, wsi, msg.data.data() + LWS_PRE, msg.data.size() - LWS_PRE, msg.is_binary))
                     {
-                        impl->_closing.store(true);
-                        impl->_isOpen.store(false);
-                        emitError(impl, "[deepgrampp] lws_write failed");
                         return -1;
                     }
+                    recycle(impl, std::move(msg.data));
                     impl->_sendQueue.pop();
-                    if (!impl->_sendQueue.empty())
+                }
+                else if (impl->_frameSource && impl->_pullRequested.exchange(false))
+                {
+                    const std::size_t size = impl->_frameSource(impl->_pullBuffer.data() + LWS_PRE, kPullFrameBytes);
+                    if (size > 0)
                     {
-                        lws_callback_on_writable(wsi);
+                        if (!writeFrame(impl, wsi, impl->_pullBuffer.data() + LWS_PRE, size, true))
+                        {
+                            return -1;
+                        }
+                        // Keep pulling until the source runs dry.
+                        impl->_pullRequested.store(true);
                     }
                 }
+                if (!impl->_sendQueue.empty() || (impl->_frameSource && impl->_pullRequested.load()))
+                {
+                    lws_callback_on_writable(wsi);
+                }
                 break;
             }
 
@@ -337,7 +406,8 @@ namespace deepgram
                 if (impl->_wsi)
                 {
                     std::lock_guard<std::mutex> lk(impl->_queueMutex);
-                    if (!impl->_sendQueue.empty() || impl->_closing.load())
+                    if (!impl->_sendQueue.empty() || impl->_closing.load() ||
+                        (impl->_frameSource && impl->_pullRequested.load()))
                     {
                         lws_callback_on_writable(impl->_wsi);
                     }
@@ -534,43 +604,50 @@ namespace deepgram
 
         void LwsWebSocketTransport::sendText(const std::string &message)
         {
-            if (!_impl->_isOpen.load())
-            {
-                throw std::runtime_error("[deepgrampp] WebSocket is not open");
-            }
+            sendText(message.data(), message.size());
+        }
 
-            LwsWebSocketTransportImpl::OutboundMsg msg;
-            msg.is_binary = false;
-            msg.data.resize(LWS_PRE + message.size());
-            std::memcpy(msg.data.data() + LWS_PRE, message.data(), message.size());
+        void LwsWebSocketTransport::sendBinary(const std::vector<std::uint8_t> &payload)
+        {
+            sendBinary(payload.data(), payload.size());
+        }
 
+        void LwsWebSocketTransport::sendText(const char *data, std::size_t size)
+        {
+            if (!_impl->_isOpen.load())
             {
-                std::lock_guard<std::mutex> lk(_impl->_queueMutex);
-                _impl->_sendQueue.push(std::move(msg));
+                throw std::runtime_error("[deepgrampp] WebSocket is not open");
             }
-            lws_cancel_service(_impl->_ctx);
+            enqueue(_impl.get(), false, data, size);
         }
 
-        void LwsWebSocketTransport::sendBinary(const std::vector<std::uint8_t> &payload)
+        void LwsWebSocketTransport::sendBinary(const std::uint8_t *data, std::size_t size)
         {
             if (!_impl->_isOpen.load())
             {
                 throw std::runtime_error("[deepgrampp] WebSocket is not open");
             }
+            enqueue(_impl.get(), true, data, size);
+        }
 
-            LwsWebSocketTransportImpl::OutboundMsg msg;
-            msg.is_binary = true;
-            msg.data.resize(LWS_PRE + payload.size());
-            if (!payload.empty())
+        bool LwsWebSocketTransport::setBinaryFrameSource(BinaryFrameSource source)
+        {
+            std::lock_guard<std::mutex> lk(_impl->_queueMutex);
+            if (source && _impl->_pullBuffer.empty())
             {
-                std::memcpy(msg.data.data() + LWS_PRE, payload.data(), payload.size());
+                _impl->_pullBuffer.resize(LWS_PRE + kPullFrameBytes);
             }
+            _impl->_frameSource = std::move(source);
+            return true;
+        }
 
+        void LwsWebSocketTransport::requestPull()
+        {
+            _impl->_pullRequested.store(true);
+            if (_impl->_ctx)
             {
-                std::lock_guard<std::mutex> lk(_impl->_queueMutex);
-                _impl->_sendQueue.push(std::move(msg));
+                lws_cancel_service(_impl->_ctx);
             }
-            lws_cancel_service(_impl->_ctx);
         }
 
         void LwsWebSocketTransport::close()
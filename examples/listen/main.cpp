@@ -69,7 +69,7 @@ int testListen(const char* apiKey, const std::string& audioFilePath)
 
         client.setOnSpeechStarted([](const deepgram::listen::SpeechStarted& speechStarted) { spdlog::info(">>> Speech started."); });
         client.setUtteranceEndCallback([](const deepgram::listen::UtteranceEnd& utteranceEnd) { spdlog::info("<<< Utterance ended."); });
-        client.setOnMetadata([](const nlohmann::json& metadata) { spdlog::info("Received metadata: {}", metadata.dump()); });
+        client.setOnMetadata([](const deepgram::listen::Metadata& metadata) { spdlog::info("Received metadata: request {} ({} channels)", metadata.request_id, metadata.channels); });
 
         // Start receiving messages
         client.startReceiving();